@@ -0,0 +1,116 @@
+/**
+ * @file CloudFile.h
+ * @brief Header file for class CloudFile
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef CLOUDFILE_H
+#define CLOUDFILE_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Point.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+#define CLOUD_MAGIC 0x444c434e // "NCLD" in little endian
+#define CLOUD_VERSION 1
+#define CLOUD_ALIGN 64
+
+// Encoding of the coordinates
+enum CloudEncoding : uint32_t {
+  CLOUD_F32 = 0, // 32-bit floats
+  CLOUD_F16 = 1, // 16-bit floats
+  CLOUD_Q16 = 2  // 16-bit integers quantized on the chunk bounding box
+};
+
+// File header, the chunk table follows at the given byte offset
+struct CloudHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t encoding;
+  uint32_t chunk_size; // Max number of points of a chunk
+  uint64_t n_pnts;     // Number of points
+  uint64_t n_chunks;   // Number of chunks
+  uint64_t table_ofs;  // Chunk table offset
+  float min[3];        // Cloud bounding box
+  float max[3];
+};
+
+// Chunk of points stored as three coordinate columns
+struct CloudChunk {
+  uint64_t ofs;   // Columns offset
+  uint64_t count; // Number of points
+  float min[3];   // Chunk bounding box
+  float max[3];
+};
+
+class CloudFile {
+private:
+  int fd_;            // File descriptor
+  size_t size_;       // Mapped size
+  const char *data_;  // Mapped memory
+
+public:
+  // Map a file in memory
+  CloudFile(const std::string &path);
+  CloudFile(const CloudFile &) = delete;
+  CloudFile &operator=(const CloudFile &) = delete;
+  // Unmap the file
+  ~CloudFile();
+
+  // Get the header
+  const CloudHeader &header() const {
+    return *reinterpret_cast<const CloudHeader *>(data_);
+  }
+  // Get the mapped size
+  const size_t &size() const { return size_; }
+
+  // Get the number of chunks
+  size_t n_chunks() const { return header().n_chunks; }
+  // Get the i-th chunk
+  const CloudChunk &chunk(size_t i) const {
+    return reinterpret_cast<const CloudChunk *>(data_ +
+                                                header().table_ofs)[i];
+  }
+
+  // Decode the coordinates of the i-th chunk
+  void decode(size_t i, float *x, float *y, float *z) const;
+
+  // Read all points
+  void read(std::list<Point> &pntcloud) const;
+  void read(std::vector<Point> &pntcloud) const;
+  // Read the points inside an axis-aligned box, skipping the other chunks
+  void read(const Point &min, const Point &max,
+            std::vector<Point> &pntcloud) const;
+
+  // Write a point cloud
+  static void write(const std::string &path,
+                    const std::vector<Point> &pntcloud,
+                    CloudEncoding encoding = CLOUD_F32,
+                    size_t chunk_size = 4096);
+  static void write(const std::string &path, const std::list<Point> &pntcloud,
+                    CloudEncoding encoding = CLOUD_F32,
+                    size_t chunk_size = 4096);
+};
+
+// Import the vertices of a PLY file (ascii or binary)
+void import_ply(const std::string &path, std::vector<Point> &pntcloud);
+
+// Import the points of a PCD file (ascii or binary)
+void import_pcd(const std::string &path, std::vector<Point> &pntcloud);
+
+} // namespace nav
+
+#endif /* CLOUDFILE_H */
@@ -0,0 +1,88 @@
+/**
+ * @file ColumnMap.h
+ * @brief Header file for class ColumnMap
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef COLUMNMAP_H
+#define COLUMNMAP_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+class Planner;
+
+// Cell state bits
+enum CellState : uint8_t {
+  CELL_IN = 1 << 0,  // Cell inside the map
+  CELL_FREE = 1 << 1 // Cell free
+};
+
+// Run of cells with the same state, it lasts until the next run
+struct Run {
+  uint32_t z;     // First z-index of the run
+  uint32_t state; // State of the cells
+};
+
+class ColumnMap {
+private:
+  size_t nx_, ny_, nz_;                 // Number of cells
+  std::vector<std::vector<Run>> cols_;  // Runs of each xy-column
+
+public:
+  // Default constructor
+  ColumnMap() : nx_(0), ny_(0), nz_(0) {}
+
+  // Initialize a map with all cells in the same state
+  ColumnMap(size_t nx, size_t ny, size_t nz, uint8_t state);
+
+  // Initialize a map from a dense grid (z-index fastest)
+  ColumnMap(size_t nx, size_t ny, size_t nz,
+            const std::vector<uint8_t> &dense);
+
+  // Initialize a map from the boxes of a planner
+  ColumnMap(const Planner &planner);
+
+  // Convert the map in a dense grid (z-index fastest)
+  std::vector<uint8_t> to_dense() const;
+
+  // Get the state of a cell
+  uint8_t state(size_t ix, size_t iy, size_t iz) const;
+  // Get the state of a cell from the linear index used by Planner
+  uint8_t state(size_t ind) const {
+    return state(ind / (nz_ * ny_), (ind / nz_) % ny_, ind % nz_);
+  }
+
+  // Set the state of a cell
+  void set(size_t ix, size_t iy, size_t iz, uint8_t state);
+
+  // Get the runs of a column
+  const std::vector<Run> &runs(size_t ix, size_t iy) const {
+    return cols_[iy + ny_ * ix];
+  }
+
+  // Get the total number of runs
+  size_t n_runs() const;
+
+  // Get number of cells
+  const size_t &nx() const { return nx_; }
+  const size_t &ny() const { return ny_; }
+  const size_t &nz() const { return nz_; }
+};
+
+} // namespace nav
+
+#endif /* COLUMNMAP_H */
@@ -15,6 +15,9 @@
 #include <GL/glew.h>
 #include <GL/glut.h>
 #include <cmath>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
 
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
@@ -44,6 +47,109 @@ void draw_cylinder(float x, float y, float z, float radius, float height);
 void draw_polyhedron(const nav::Point &p1, const nav::Point &p2,
                      const nav::Point &p3, const nav::Point &p4, float height);
 
+// Vertices of one primitive kept in a buffer object on the GPU. The meshes
+// are appended on the host and only the range added since the last draw is
+// uploaded, so a static map costs one upload and a growing one its growth.
+class MeshBuffer {
+private:
+  GLenum mode_;               // Primitive of the vertices
+  GLuint vbo_;                // Buffer object, created at the first draw
+  size_t capacity_;           // Vertices allocated in the buffer object
+  size_t uploaded_;           // Vertices already in the buffer object
+  std::vector<GLfloat> data_; // Coordinates of the vertices
+
+public:
+  // Initialize an empty buffer of points, lines or triangles
+  MeshBuffer(GLenum mode = GL_TRIANGLES);
+  MeshBuffer(MeshBuffer &&other);
+  MeshBuffer(const MeshBuffer &) = delete;
+  MeshBuffer &operator=(const MeshBuffer &) = delete;
+  // Release the buffer object, the GL context must still be current
+  ~MeshBuffer();
+
+  // Get the number of vertices
+  size_t size() const { return data_.size() / 3; }
+  // Remove all the vertices, the buffer object is kept for reuse
+  void clear();
+
+  // Append a point, for GL_POINTS
+  void add_point(const nav::Point &pnt);
+  // Append a segment, for GL_LINES
+  void add_link(const nav::Point &src, const nav::Point &dst);
+  // Append the 12 triangles of a box, for GL_TRIANGLES
+  void add_box(const nav::Point &cnt, float xlen, float ylen, float zlen);
+  // Append the triangles of a capped cylinder, for GL_TRIANGLES
+  void add_cylinder(const nav::Point &cnt, float radius, float height);
+
+  // Upload the new vertices and draw all of them with the current color
+  void draw();
+};
+
+// Planes of the view volume and position of the camera, read from the
+// projection and modelview matrices of the fixed pipeline
+class Frustum {
+private:
+  float planes_[6][4]; // Inward planes as (a, b, c, d)
+  float eye_[3];       // Position of the camera
+
+public:
+  // Read the current matrices, after the view is activated
+  void update();
+
+  // Check if a box touches the view volume, conservatively
+  bool intersects(const float *min, const float *max) const;
+  // Get the distance of a box from the camera, zero inside it
+  float distance(const float *min, const float *max) const;
+};
+
+// Meshes split in square chunks on the xy plane, drawn only when they touch
+// the view volume. Each chunk also keeps an aggregated mesh, one point or
+// one box per cell of the coarse grid, drawn beyond the LOD distance.
+class ChunkGrid {
+private:
+  struct Chunk {
+    float min[3], max[3];              // Bounds of the vertices
+    MeshBuffer fine, coarse;           // Full and aggregated meshes
+    std::unordered_set<int64_t> cells; // Coarse cells already drawn
+    Chunk(GLenum mode);
+  };
+
+  float chunk_len_;           // Side of the chunks
+  float cell_len_;            // Side of the coarse cells
+  float lod_dist_;            // Distance of the aggregated meshes
+  size_t nx_, ny_;            // Chunks along x and y
+  std::vector<Chunk> chunks_; // Chunks, ind = iy + ny * ix
+  size_t drawn_;              // Vertices drawn by the last call
+
+  // Get the chunk of a point, the outer ones take the points out of bounds
+  Chunk &chunk(const nav::Point &pnt);
+  // Mark the coarse cell of a point, false if already marked
+  bool new_cell(Chunk &chunk, const nav::Point &pnt);
+  // Get the center of the coarse cell of a point
+  nav::Point cell_cnt(const nav::Point &pnt) const;
+  // Extend the bounds of a chunk
+  static void extend(Chunk &chunk, const nav::Point &cnt, float xlen,
+                     float ylen, float zlen);
+
+public:
+  // Initialize the chunks covering a map of xlen x ylen
+  ChunkGrid(GLenum mode, float xlen, float ylen, float chunk_len,
+            float cell_len, float lod_dist);
+
+  // Append a point, for GL_POINTS
+  void add_point(const nav::Point &pnt);
+  // Append a segment to the chunk of its source, for GL_LINES. The
+  // segments have no aggregated mesh and vanish beyond the LOD distance.
+  void add_link(const nav::Point &src, const nav::Point &dst);
+  // Append a box, for GL_TRIANGLES
+  void add_box(const nav::Point &cnt, float xlen, float ylen, float zlen);
+
+  // Draw the visible chunks with the current color
+  void draw(const Frustum &frustum);
+  // Get the vertices drawn by the last call
+  const size_t &drawn() const { return drawn_; }
+};
+
 } // namespace gl
 
 #endif /* DRAWER_H */
\ No newline at end of file
@@ -11,17 +11,24 @@
 /*---------------------------------------------------------------------------*/
 /*                          Standard header includes                         */
 /*---------------------------------------------------------------------------*/
+#include <boost/serialization/split_member.hpp>
+#include <cstdint>
+#include <queue>
 
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
-#include "Point.h"
+#include "Box.h"
+#include "Stats.h"
+#include "Trace.h"
 
 /*---------------------------------------------------------------------------*/
 /*                              Class Definition                             */
 /*---------------------------------------------------------------------------*/
 namespace nav {
 
+class MapFile;
+
 class ExpBox {
 private:
   size_t ind_;
@@ -89,13 +96,49 @@ private:
   float xstep_, ystep_;       // Steps length
   float radius_;              // Drone dimensions
   std::vector<ExpBox> boxes_; //
+  std::vector<size_t> frontier_;     // Unexplored free boxes next to explored
+  std::vector<size_t> frontier_pos_; // Position of each box in the frontier
+  std::vector<float> fdist_;         // Travel distance to the closest frontier
+  std::vector<size_t> fnext_;        // Next box towards the closest frontier
+  std::vector<size_t> fsrc_;         // Closest frontier box
+  std::vector<size_t> pending_;      // Boxes explored since the last update
+  std::vector<uint32_t> sat_;        // Summed-area table of unexplored boxes
+  ExplorerStats stats_;              // Counters and timers (NAV_STATS only)
+
+  // Min-queue of the boxes whose distance has been lowered
+  typedef std::priority_queue<Node, std::vector<Node>, std::greater<Node>>
+      NodeQueue;
+
+  // Rebuild the frontier and its distance field from the explored flags
+  void init_frontier();
+  // Add a box to the frontier, return false if it cannot be added
+  bool add_frontier(size_t ind);
+  // Remove a box from the frontier
+  void rm_frontier(size_t ind);
+  // Propagate the distance field from the boxes in the queue
+  void propagate(NodeQueue &OPEN);
+  // Repair the distance field around the boxes explored since the last update
+  void update_field();
+  // Build the summed-area table of the unexplored free boxes
+  void build_sat();
+  // Count the unexplored free boxes in the view of a box from the table
+  size_t sat_gain(size_t ind, size_t hx, size_t hy) const;
 
   // Exp Map serialization
   friend class boost::serialization::access;
+  friend class MapFile;
   template <typename Archive>
-  void serialize(Archive &ar, const unsigned int version) {
+  void save(Archive &ar, const unsigned int version) const {
+    ar &xlen_ &ylen_ &nx_ &ny_ &n_ &xstep_ &ystep_ &radius_ &boxes_;
+  }
+  template <typename Archive>
+  void load(Archive &ar, const unsigned int version) {
     ar &xlen_ &ylen_ &nx_ &ny_ &n_ &xstep_ &ystep_ &radius_ &boxes_;
+    // The frontier and the gain table are rebuilt from the explored flags
+    frontier_pos_.clear();
+    sat_.clear();
   }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 public:
   // Default constructor
@@ -111,13 +154,52 @@ public:
   // Get boxes
   const std::vector<ExpBox> &boxes() const { return boxes_; }
 
-  //
-  void set_explored(size_t ind) {
-    boxes_[ind].set_explored();
-    for (nav::WtEdge edge : this->boxes_[ind].edges()) {
-      this->boxes_[edge.first].set_f(this->boxes_[edge.first].f() - 1);
-    }
+  // Set a box as explored and update the frontier
+  void set_explored(size_t ind);
+  // Set the free boxes in the view of a box as explored, the view is the
+  // square of half side range around it
+  void set_explored(size_t ind, float range);
+
+  // Get the frontier boxes
+  const std::vector<size_t> &frontier() {
+    if (frontier_pos_.size() != n_)
+      init_frontier();
+    return frontier_;
+  }
+  // Group the frontier boxes in connected clusters
+  std::vector<std::vector<size_t>> frontier_clusters();
+
+  // Get the travel distance through explored boxes to the closest frontier
+  // box (INF if none can be reached)
+  float frontier_dist(size_t ind) {
+    update_field();
+    return fdist_[ind];
   }
+  // Get the next box towards the closest frontier box (-1 if none)
+  size_t frontier_next(size_t ind) {
+    update_field();
+    return fnext_[ind];
+  }
+
+  // Compute the path to the closest frontier box by travel distance through
+  // explored boxes, ties are broken by the fewest unexplored neighbors
+  bool next_goal(size_t curr_ind, std::list<size_t> &path);
+
+  // Count the unexplored free boxes in the view of a box
+  size_t info_gain(size_t ind, float range);
+  // Count the unexplored free boxes in the view of each box
+  void info_gain(const std::vector<size_t> &inds, float range,
+                 std::vector<size_t> &gains, size_t n_threads = 1);
+
+  // Compute the path to the frontier box with the best view, scored as the
+  // information gain discounted by exp(-lambda * travel distance)
+  bool next_view(size_t curr_ind, float range, float lambda,
+                 std::list<size_t> &path, size_t n_threads = 1);
+
+  // Get the counters and the timers, kept only when built with NAV_STATS
+  const ExplorerStats &stats() const { return stats_; }
+  // Set the counters and the timers to zero
+  void reset_stats() { stats_.reset(); }
 
   // Compute the index of the corresponding box
   size_t pnt_to_ind(const Point &pnt);
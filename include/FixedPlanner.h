@@ -0,0 +1,53 @@
+/**
+ * @file FixedPlanner.h
+ * @brief Header file for class FixedPlanner
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef FIXEDPLANNER_H
+#define FIXEDPLANNER_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Planner.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Planner on a grid sized at compile time, for deployments on a fixed map.
+// The boxes are built by the same code as the planner sized at run time, with
+// the strides, the link stencil and the bounds checks folded into constants,
+// so both give the same map. Searches and updates are the planner ones.
+template <size_t NX, size_t NY, size_t NZ, Connectivity LINKS = LINKS_10>
+class FixedPlanner : public Planner {
+public:
+  typedef FixedGrid<NX, NY, NZ, LINKS> Grid;
+
+  // Initialize a map
+  FixedPlanner(float xlen, float ylen, float zlen, float radius, float height,
+               const std::list<Point> &fix_pntcloud)
+      : Planner(xlen, ylen, zlen, NX, NY, NZ, radius, height) {
+    NAV_TRACE("FixedPlanner::FixedPlanner");
+    this->build(Grid(), fix_pntcloud);
+  }
+
+  // Initialize a map from an occupancy grid (z-index fastest, CellState bits)
+  FixedPlanner(float xlen, float ylen, float zlen, float radius, float height,
+               const std::vector<uint8_t> &occupancy)
+      : Planner(xlen, ylen, zlen, NX, NY, NZ, radius, height) {
+    NAV_TRACE("FixedPlanner::FixedPlanner");
+    this->build(Grid(), occupancy);
+  }
+};
+
+} // namespace nav
+
+#endif /* FIXEDPLANNER_H */
@@ -0,0 +1,150 @@
+/**
+ * @file Fleet.h
+ * @brief Header file for class Fleet
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef FLEET_H
+#define FLEET_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Planner.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Space-time reservations of the boxes. A drone reserves at each time all
+// the boxes where the center of another drone would hit its body, so a box
+// is free when its center keeps clear of all the reserved drones.
+class ReservationTable {
+private:
+  size_t n_;                                  // Number of boxes
+  std::unordered_set<uint64_t> cells_;        // Reserved (time, box) pairs
+  std::unordered_map<size_t, size_t> last_;   // Last reserved time of a box
+  std::unordered_map<size_t, size_t> parked_; // Time a box is reserved from
+
+public:
+  // Initialize an empty table on n boxes
+  ReservationTable(size_t n = 0) : n_(n) {}
+
+  // Get the number of reserved (time, box) pairs
+  size_t size() const { return cells_.size() + parked_.size(); }
+  // Remove all the reservations
+  void clear();
+
+  // Reserve a box at a time
+  void reserve(size_t ind, size_t t);
+  // Reserve a box from a time on
+  void park(size_t ind, size_t t);
+
+  // Check if a box is free at a time
+  bool is_free(size_t ind, size_t t) const {
+    auto it = parked_.find(ind);
+    return (it == parked_.end() || t < it->second) &&
+           cells_.find(t * n_ + ind) == cells_.end();
+  }
+  // Check if a box is free from a time on
+  bool is_free_from(size_t ind, size_t t) const {
+    auto it = last_.find(ind);
+    return parked_.find(ind) == parked_.end() &&
+           (it == last_.end() || it->second < t);
+  }
+};
+
+// Drone of a fleet
+struct Agent {
+  size_t str;                 // Current box
+  size_t trg;                 // Target box
+  std::vector<size_t> plan;   // Box at each time of the window, str first
+  std::vector<uint32_t> dist; // Steps to the target ignoring the other drones
+  size_t moves;               // Steps to another box
+  size_t waits;               // Steps in the same box before the target
+  Agent(size_t str, size_t trg)
+      : str(str), trg(trg), plan(1, str), moves(0), waits(0) {}
+  // Check if the drone rests on its target
+  bool arrived() const { return str == trg && plan.size() == 1; }
+};
+
+// Drones flying on one shared map, planned with windowed cooperative A*.
+// The drones are searched one after the other in space-time, each one
+// avoiding the reservations of the previous ones, and the plans are redone
+// every half window while the drones move. Each drone also holds its current
+// box for the whole window, so one that finds no plan waits there safely.
+// The searches that do not meet run in parallel: all the drones are first
+// searched against the held boxes, then each plan is kept if it still fits
+// the reservations before it, otherwise searched again.
+class Fleet {
+private:
+  const Planner *map_;        // Shared map (not owned)
+  size_t window_;             // Depth of the space-time searches
+  size_t n_threads_;          // Threads of the parallel searches
+  std::vector<Agent> agents_; // Drones
+  ReservationTable table_;    // Reservations of the current plans
+  size_t time_;               // Steps done
+  size_t planned_;            // Step of the last plans
+  size_t failures_;           // Drones left waiting without a plan
+  size_t kept_;               // Parallel plans kept as they were
+  // Boxes hit by the body of a drone, as offsets along x, y and z
+  std::vector<std::array<long, 3>> offsets_;
+  // Drones holding each box during the current window
+  std::vector<uint16_t> stays_;
+
+  // Fill the steps to the target of a drone on the free boxes
+  void fill_dist(Agent &agent) const;
+  // Search the plan of a drone against the current reservations
+  bool search(const Agent &agent, std::vector<size_t> &plan) const;
+  // Check if a plan still fits the current reservations
+  bool fits(const Agent &agent, const std::vector<size_t> &plan) const;
+  // Get the boxes hit by the body of a drone centered in a box
+  void hit(size_t ind, std::vector<size_t> &boxes) const;
+  // Reserve the boxes hit by a drone at a time, or from a time on
+  void reserve(size_t ind, size_t t, bool park);
+  // Reserve the plan of a drone
+  void reserve(const Agent &agent);
+
+public:
+  // Initialize an empty fleet on a map, the map must outlive the fleet
+  Fleet(const Planner &map, size_t window = 16, size_t n_threads = 1);
+
+  // Add a drone between two points, return its id
+  size_t add_agent(const Point &str, const Point &trg);
+  // Check if two drones centered in two boxes collide
+  bool collide(size_t a, size_t b) const;
+  // Get the drones
+  const std::vector<Agent> &agents() const { return agents_; }
+  // Get the reservations, times count from the last plans
+  const ReservationTable &table() const { return table_; }
+
+  // Get the steps done
+  const size_t &time() const { return time_; }
+  // Get the drones left waiting without a plan so far
+  const size_t &failures() const { return failures_; }
+  // Get the parallel plans kept without searching them again so far
+  const size_t &kept() const { return kept_; }
+
+  // Plan all the drones for the next window, return how many got a plan
+  size_t plan();
+  // Move all the drones one step, planning again when needed. Return false
+  // when all the drones are on their targets.
+  bool step();
+  // Check if all the drones are on their targets
+  bool done() const;
+};
+
+} // namespace nav
+
+#endif /* FLEET_H */
@@ -0,0 +1,134 @@
+/**
+ * @file Grid.h
+ * @brief Header file for the grid geometries
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef GRID_H
+#define GRID_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Boxes linked to a box: the 6 sharing a face, the 8 around it on the plane
+// plus the ones above and below, or all the 26 around it
+enum Connectivity { LINKS_6 = 6, LINKS_10 = 10, LINKS_26 = 26 };
+
+// Check if the box at offsets i, j and k along x, y and z is linked
+constexpr bool is_link(Connectivity links, int i, int j, int k) {
+  return (i != 0 || j != 0 || k != 0) &&
+         (links == LINKS_26 ||
+          (links == LINKS_10 && (k == 0 || (i == 0 && j == 0))) ||
+          (links == LINKS_6 && (i != 0) + (j != 0) + (k != 0) == 1));
+}
+
+// Grid of boxes sized at run time
+class RuntimeGrid {
+private:
+  size_t nx_, ny_, nz_; // Number of boxes
+  Connectivity links_;  // Boxes linked to a box
+
+public:
+  RuntimeGrid(size_t nx, size_t ny, size_t nz, Connectivity links = LINKS_10)
+      : nx_(nx), ny_(ny), nz_(nz), links_(links) {}
+
+  // Get number of boxes
+  size_t nx() const { return nx_; }
+  size_t ny() const { return ny_; }
+  size_t nz() const { return nz_; }
+  size_t n() const { return nx_ * ny_ * nz_; }
+  // Get the boxes linked to a box
+  Connectivity links() const { return links_; }
+};
+
+// Grid of boxes sized at compile time, the strides, the link stencil and the
+// bounds checks fold into constants
+template <size_t NX, size_t NY, size_t NZ, Connectivity LINKS = LINKS_10>
+class FixedGrid {
+  static_assert(NX > 0 && NY > 0 && NZ > 0, "Grid must not be empty");
+
+public:
+  // Get number of boxes
+  static constexpr size_t nx() { return NX; }
+  static constexpr size_t ny() { return NY; }
+  static constexpr size_t nz() { return NZ; }
+  static constexpr size_t n() { return NX * NY * NZ; }
+  // Get the boxes linked to a box
+  static constexpr Connectivity links() { return LINKS; }
+};
+
+// The functions below work on both grids, z index fastest
+
+// Convert three-dimensional indexes into a linear index, n if out of the grid
+template <class Grid>
+inline size_t grid_ind(const Grid &grid, long x, long y, long z) {
+  if (x < 0 || x >= (long)grid.nx() || y < 0 || y >= (long)grid.ny() ||
+      z < 0 || z >= (long)grid.nz())
+    return grid.n();
+  return z + grid.nz() * (y + grid.ny() * x);
+}
+
+// Convert a linear index into three-dimensional indexes
+template <class Grid>
+inline void grid_sub(const Grid &grid, size_t ind, long &x, long &y, long &z) {
+  z = ind % grid.nz();
+  y = (ind / grid.nz()) % grid.ny();
+  x = ind / (grid.nz() * grid.ny());
+}
+
+// Append the boxes within a level of a box, x first and z last
+template <class Grid>
+void grid_neighs(const Grid &grid, size_t ind, long xy_level, long z_level,
+                 std::vector<size_t> &neighs) {
+  long x, y, z;
+  grid_sub(grid, ind, x, y, z);
+  long x0 = std::max(x - xy_level, 0L),
+       x1 = std::min(x + xy_level, (long)grid.nx() - 1);
+  long y0 = std::max(y - xy_level, 0L),
+       y1 = std::min(y + xy_level, (long)grid.ny() - 1);
+  long z0 = std::max(z - z_level, 0L),
+       z1 = std::min(z + z_level, (long)grid.nz() - 1);
+  for (long i = x0; i <= x1; i++) {
+    for (long j = y0; j <= y1; j++) {
+      size_t col = grid.nz() * (j + grid.ny() * i);
+      for (long k = z0; k <= z1; k++)
+        neighs.push_back(col + k);
+    }
+  }
+}
+
+// Append the boxes linked to a box, x first and z last
+template <class Grid>
+void grid_links(const Grid &grid, size_t ind, std::vector<size_t> &links) {
+  long x, y, z;
+  grid_sub(grid, ind, x, y, z);
+  for (int i = -1; i <= 1; i++) {
+    for (int j = -1; j <= 1; j++) {
+      for (int k = -1; k <= 1; k++) {
+        if (!is_link(grid.links(), i, j, k))
+          continue;
+        size_t link = grid_ind(grid, x + i, y + j, z + k);
+        if (link < grid.n())
+          links.push_back(link);
+      }
+    }
+  }
+}
+
+} // namespace nav
+
+#endif /* GRID_H */
@@ -0,0 +1,70 @@
+/**
+ * @file Histogram.h
+ * @brief Header file for class LatencyHistogram
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Histogram of latencies in nanoseconds with log-linear buckets: each power
+// of two is split in SUB_BUCKETS buckets, so a percentile is off by less
+// than 1 / SUB_BUCKETS of its value. Recording is constant time.
+class LatencyHistogram {
+private:
+  static const size_t SUB_BITS = 5;
+  static const size_t SUB_BUCKETS = 1 << SUB_BITS;
+
+  std::vector<uint64_t> counts_; // Counts of the buckets, empty until used
+  uint64_t count_;               // Recorded values
+  uint64_t min_ns_, max_ns_;     // Extreme values
+  double sum_ns_;                // Sum of the values
+
+  // Get the bucket of a value
+  static size_t bucket(uint64_t ns);
+  // Get the highest value of a bucket
+  static uint64_t bucket_max(size_t ind);
+
+public:
+  // Initialize an empty histogram
+  LatencyHistogram() { reset(); }
+
+  // Record a latency
+  void record_ns(uint64_t ns);
+  void record_ms(double ms) { record_ns(ms > 0.0 ? (uint64_t)(ms * 1e6) : 0); }
+  // Remove all the values
+  void reset();
+  // Add the values of another histogram
+  void merge(const LatencyHistogram &other);
+
+  // Get the number of values
+  const uint64_t &count() const { return count_; }
+  // Get the extreme values and the mean
+  double min_ms() const { return count_ ? min_ns_ / 1e6 : 0.0; }
+  double max_ms() const { return max_ns_ / 1e6; }
+  double mean_ms() const { return count_ ? sum_ns_ / count_ / 1e6 : 0.0; }
+  // Get the value below which p percent of the values fall
+  double percentile_ms(double p) const;
+
+  // Write count, mean, p50, p90, p99, p99.9 and max on one line
+  std::string summary() const;
+  // Write the same values as a JSON object
+  std::string to_json() const;
+};
+
+} // namespace nav
+
+#endif /* HISTOGRAM_H */
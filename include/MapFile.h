@@ -0,0 +1,129 @@
+/**
+ * @file MapFile.h
+ * @brief Header file for class MapFile
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Explorer.h"
+#include "Planner.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+#define MAP_MAGIC 0x50414d4e // "NMAP" in little endian
+#define MAP_VERSION 1
+#define MAP_ALIGN 64
+
+// Kind of map stored in the file
+enum MapKind : uint32_t { MAP_PLANNER = 1, MAP_EXPLORER = 2 };
+
+// Box state bits
+enum MapState : uint8_t {
+  MAP_IN = 1 << 0,         // Box inside the map
+  MAP_FREE = 1 << 1,       // Box free
+  MAP_UPDATABLE = 1 << 2,  // Box updatable by SLAM points
+  MAP_EXPLORED = 1 << 3    // Box explored
+};
+
+// Sections of the file, each one is an aligned array
+enum MapSection {
+  MAP_STATE,     // uint8_t[n]
+  MAP_CNTS,      // float[3n]
+  MAP_NEIGH_OFS, // uint64_t[n+1]
+  MAP_NEIGHS,    // uint32_t[]
+  MAP_EDGE_OFS,  // uint64_t[n+1]
+  MAP_EDGE_DST,  // uint32_t[]
+  MAP_EDGE_WT,   // float[]
+  MAP_F,         // uint32_t[n] (explorer only)
+  MAP_FIX_OFS,   // uint64_t[n+1] (optional)
+  MAP_FIX_PNTS,  // float[3k] (optional)
+  MAP_SLAM_OFS,  // uint64_t[n+1] (optional)
+  MAP_SLAM_PNTS, // float[3k] (optional)
+  MAP_SECTIONS
+};
+
+// File header, the sections follow at the given byte offsets
+struct MapHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t kind;
+  uint32_t has_pnts;
+  float xlen, ylen, zlen;       // Map dimension
+  float xstep, ystep, zstep;    // Steps length
+  float radius, height;         // Drone dimensions
+  uint64_t nx, ny, nz, n;       // Number of boxes
+  uint64_t str, trg;            // Start and target boxes
+  uint64_t ofs[MAP_SECTIONS];   // Sections offsets
+  uint64_t len[MAP_SECTIONS];   // Sections lengths in bytes
+};
+
+// Map file mapped read-only in memory. The sections can be read in place, but
+// load copies them into the vectors of the boxes.
+class MapFile {
+private:
+  std::string path_;  // File path
+  int fd_;            // File descriptor
+  size_t size_;       // Mapped size
+  const char *data_;  // Mapped memory
+
+public:
+  // Map a file in memory
+  MapFile(const std::string &path);
+  MapFile(const MapFile &) = delete;
+  MapFile &operator=(const MapFile &) = delete;
+  // Unmap the file
+  ~MapFile();
+
+  // Get the header
+  const MapHeader &header() const {
+    return *reinterpret_cast<const MapHeader *>(data_);
+  }
+
+  // Get a section as a typed array
+  template <typename T> const T *section(MapSection sec) const {
+    return reinterpret_cast<const T *>(data_ + header().ofs[sec]);
+  }
+  // Get the number of elements of a section
+  template <typename T> size_t count(MapSection sec) const {
+    return header().len[sec] / sizeof(T);
+  }
+
+  // Get the state of the ind-th box
+  uint8_t state(size_t ind) const { return section<uint8_t>(MAP_STATE)[ind]; }
+  // Get the center of the ind-th box
+  Point cnt(size_t ind) const {
+    const float *c = section<float>(MAP_CNTS) + 3 * ind;
+    return Point(c[0], c[1], c[2]);
+  }
+
+  // Fill a planner with the content of the file
+  void load(Planner &planner, bool with_pnts = false) const;
+  // Fill an explorer with the content of the file
+  void load(Explorer &explorer, bool with_pnts = false) const;
+
+  // Write a planner
+  static void write(const std::string &path, const Planner &planner,
+                    bool with_pnts = false);
+  // Write an explorer
+  static void write(const std::string &path, const Explorer &explorer,
+                    bool with_pnts = false);
+};
+
+} // namespace nav
+
+#endif /* MAPFILE_H */
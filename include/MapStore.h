@@ -0,0 +1,84 @@
+/**
+ * @file MapStore.h
+ * @brief Header file for class MapStore
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef MAPSTORE_H
+#define MAPSTORE_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "ColumnMap.h"
+#include "Planner.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Immutable version of the occupancy of a planner
+struct MapSnapshot {
+  uint64_t epoch; // Version, increasing with each publish
+  ColumnMap occ;  // Occupancy of the boxes
+  MapSnapshot(uint64_t epoch, const ColumnMap &occ) : epoch(epoch), occ(occ) {}
+};
+
+// Versioned occupancy of a planner. SLAM points are ingested in a back buffer
+// and published as immutable snapshots, so a search on a snapshot never sees
+// it change while new points keep coming. A snapshot is freed when its last
+// reader drops it.
+class MapStore {
+private:
+  const Planner *planner_;                   // Box geometry (not owned)
+  std::mutex mutex_;                         // Serializes ingest and publish
+  ColumnMap back_;                           // Back buffer
+  size_t n_busy_;                            // Boxes set busy by ingestion
+  uint64_t epoch_;                           // Last published version
+  std::shared_ptr<const MapSnapshot> front_; // Last published snapshot
+
+  // Set busy the boxes whose drone cylinder contains the point
+  size_t ingest_pnt(const Point &pnt);
+  // Ingest a range of points, the lock must be held
+  template <typename It> size_t ingest_range(It first, It last) {
+    size_t count = 0;
+    for (; first != last; first++)
+      count += this->ingest_pnt(*first);
+    this->n_busy_ += count;
+    return count;
+  }
+
+public:
+  // Initialize the store from the boxes of a planner, that must outlive it,
+  // and publish the first snapshot
+  MapStore(const Planner &planner);
+
+  // Ingest SLAM points in the back buffer, as Planner::update does, return the
+  // number of boxes set busy
+  size_t ingest(const std::vector<Point> &pnts);
+  size_t ingest(const std::list<Point> &pnts);
+
+  // Publish the back buffer as a new snapshot, return its epoch
+  uint64_t publish();
+
+  // Get the last published snapshot, safe from any thread
+  std::shared_ptr<const MapSnapshot> snapshot() const;
+
+  // Get the number of boxes set busy by ingestion
+  size_t n_busy();
+};
+
+} // namespace nav
+
+#endif /* MAPSTORE_H */
@@ -0,0 +1,88 @@
+/**
+ * @file Pipeline.h
+ * @brief Header file for class Pipeline
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Explorer.h"
+#include "PlanWorker.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Outcome of an exploration
+struct PipelineResult {
+  bool success;                // No frontier box left
+  size_t ticks;                // Control ticks
+  size_t moves;                // Ticks that moved the drone
+  size_t stalls;               // Ticks spent waiting for a path
+  size_t goals;                // Goals proposed by the explorer
+  size_t cancelled;            // Searches dropped because the goal was seen
+  size_t unreachable;          // Goals the planner could not reach
+  double length;               // Travel distance
+  std::vector<double> tick_ms; // Latency of each tick
+  double total_ms;             // Wall time of the exploration
+  PipelineResult()
+      : success(false), ticks(0), moves(0), stalls(0), goals(0),
+        cancelled(0), unreachable(0), length(0.0), total_ms(0.0) {}
+};
+
+// Explore-then-plan loop: the explorer proposes the goals, the planner
+// searches the paths on the worker and the drone moves one box per tick. A
+// tick never waits for a search, the drone hovers while the path is missing.
+class Pipeline {
+private:
+  const Planner *planner_;  // Map of the drone (not owned)
+  Explorer explorer_;       // Explored area
+  PlanWorker worker_;       // Searches of the paths
+  float range_;             // Half side of the sensor view
+  size_t lookahead_;        // Boxes kept of the current path while replanning
+  size_t pos_;              // Current box of the planner
+  size_t goal_;             // Current goal of the explorer (-1 if none)
+  uint64_t job_;            // Request waiting for its path (0 if none)
+  std::list<size_t> path_;  // Boxes to follow
+  bool finished_;           // No frontier box left
+  PipelineResult res_;      // Counters of the exploration
+
+  // Propose the next goal from a box of the explorer
+  size_t propose_goal(size_t exp_ind);
+
+public:
+  // Initialize the loop at a start point, the planner must outlive it
+  Pipeline(const Planner &planner, const Explorer &explorer, const Point &str,
+           float range = 3.0f, size_t lookahead = 3, bool async = true);
+
+  // Get the explorer
+  const Explorer &explorer() const { return explorer_; }
+  // Get the current box of the planner
+  const size_t &pos() const { return pos_; }
+  // Get the boxes to follow
+  const std::list<size_t> &path() const { return path_; }
+  // Check if the exploration is over
+  const bool &done() const { return finished_; }
+
+  // Sense, update the goal, collect the path and move one box
+  void tick();
+
+  // Run until the exploration is over or max_ticks ticks are done, a tick
+  // starts every period_ms milliseconds (0 to run them back to back)
+  PipelineResult run(size_t max_ticks, double period_ms = 0.0);
+};
+
+} // namespace nav
+
+#endif /* PIPELINE_H */
@@ -0,0 +1,85 @@
+/**
+ * @file PlanWorker.h
+ * @brief Header file for class PlanWorker
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef PLANWORKER_H
+#define PLANWORKER_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Planner.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Outcome of a path request
+struct PlanResult {
+  uint64_t id;            // Request that produced it
+  bool success;           // Path found
+  std::string error;      // Error message on failure
+  std::list<size_t> path; // Boxes from the start (excluded) to the target
+  double search_ms;       // Latency of the search
+  PlanResult() : id(0), success(false), search_ms(0.0) {}
+};
+
+// Planner that runs the searches on a background thread. A new request
+// supersedes the pending one and cancels the running search, only the result
+// of the last request is delivered.
+class PlanWorker {
+private:
+  Planner planner_;          // Planner of the worker
+  bool async_;               // Search on the background thread
+  std::thread thread_;       // Background thread
+  std::mutex mutex_;         // Guards the members below
+  std::condition_variable cv_;
+  bool stop_;                // Stop the background thread
+  bool pending_;             // A request is waiting for the thread
+  uint64_t last_id_;         // Last request
+  Point str_, trg_;          // Endpoints of the waiting request
+  bool ready_;               // The result of the last request is waiting
+  PlanResult result_;        // Result of the last request
+  std::atomic<bool> cancel_; // Abort the running search
+
+  // Loop of the background thread
+  void run();
+  // Search a path between two points
+  PlanResult plan(uint64_t id, const Point &str, const Point &trg);
+
+public:
+  // Initialize a worker on a copy of the planner, without a thread the
+  // searches run inside request()
+  PlanWorker(const Planner &planner, bool async = true);
+  // Stop the background thread
+  ~PlanWorker();
+
+  // Check if the searches run on the background thread
+  const bool &async() const { return async_; }
+
+  // Request a path between two points, return the id of the request
+  uint64_t request(const Point &str, const Point &trg);
+  // Drop the waiting request and abort the running search
+  void cancel();
+  // Get the result of the last request without blocking, return false if it
+  // is not ready
+  bool poll(PlanResult &result);
+};
+
+} // namespace nav
+
+#endif /* PLANWORKER_H */
@@ -11,19 +11,31 @@
 /*---------------------------------------------------------------------------*/
 /*                          Standard header includes                         */
 /*---------------------------------------------------------------------------*/
+#include <atomic>
+#include <unordered_map>
 #include <unordered_set>
 
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
 #include "Box.h"
+#include "ColumnMap.h"
 #include "FibonacciHeap.h"
+#include "Grid.h"
+#include "RadixHeap.h"
+#include "ScanQueue.h"
+#include "Stats.h"
+#include "Trace.h"
 
 /*---------------------------------------------------------------------------*/
 /*                              Class Definition                             */
 /*---------------------------------------------------------------------------*/
 namespace nav {
 
+class MapFile;
+template <size_t NX, size_t NY, size_t NZ, Connectivity LINKS>
+class FixedPlanner;
+
 class Planner {
 private:
   float xlen_, ylen_, zlen_;    // Map dimension
@@ -35,27 +47,110 @@ private:
   size_t str_;                  // Start box
   size_t trg_;                  // Target box
   std::list<size_t> path_;      // Shortest path
+  Connectivity links_;          // Boxes linked to a box
+  int repair_;                  // Local repair margin (boxes, <0 disables)
+  bool int_cost_;               // Search with integer step costs
+
+  // Label of a box in the integer cost search
+  struct CostLabel {
+    uint32_t stamp; // Search that set the label
+    uint32_t g;     // Cost from the start box
+    size_t pred;    // Predecessor box
+    bool closed;    // Already expanded
+  };
+  std::vector<CostLabel> labels_; // Labels of the integer cost search
+  uint32_t stamp_;                // Current integer cost search
+  bool h_table_;                  // Heuristic filled for all boxes in set_trg
+  size_t h_trg_;                  // Target of the heuristic table
+
+  const std::atomic<bool> *cancel_; // Flag that aborts a search (not owned)
+  PlannerStats stats_;              // Counters and timers (NAV_STATS only)
 
   // Nav Map serialization
   friend class boost::serialization::access;
+  friend class MapFile;
+  template <size_t NX, size_t NY, size_t NZ, Connectivity LINKS>
+  friend class FixedPlanner;
   template <typename Archive>
   void serialize(Archive &ar, const unsigned int version) {
     ar &xlen_ &ylen_ &zlen_ &nx_ &ny_ &nz_ &n_ &xstep_ &ystep_ &zstep_ &radius_
         &height_ &boxes_ &updatable_ &str_ &trg_ &path_;
+    if (Archive::is_loading::value) {
+      links_ = find_connectivity();
+      // The heuristic table and the search labels belong to the old map
+      h_trg_ = -1;
+      labels_.clear();
+    }
   }
 
+  // Initialize the sizes of a map, the boxes are built apart
+  Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny, size_t nz,
+          float radius, float height);
+
+  // Build the boxes on a grid with fixed points
+  template <class Grid>
+  void build(const Grid &grid, const std::list<Point> &fix_pntcloud);
+  // Build the boxes on a grid from an occupancy grid
+  template <class Grid>
+  void build(const Grid &grid, const std::vector<uint8_t> &occupancy);
+  // Divide the space in boxes
+  template <class Grid> void init_boxes(const Grid &grid);
+  // Set fixed obstacles from fixed points
+  void set_fix_pnts(const std::list<Point> &fix_pntcloud);
+  // Set fixed obstacles from an occupancy grid
+  void set_occupancy(const std::vector<uint8_t> &occupancy);
+  // Link boxes close to each other
+  template <class Grid> void link_boxes(const Grid &grid);
+  // Find the connectivity of the edges of a loaded map
+  Connectivity find_connectivity() const;
+
+  // Compute shortest path, optionally checking a column map
+  void search_(const ColumnMap *occ);
+  // Compute shortest path with integer step costs on a radix queue
+  void search_int_(const ColumnMap *occ);
+  // Compute the heuristic of a box
+  float heuristic(size_t ind) const;
+
 public:
   // Default constructor
-  Planner() {}
+  Planner()
+      : str_(0), trg_(0), links_(LINKS_10), repair_(3), int_cost_(false),
+        stamp_(0), h_table_(false), h_trg_(-1), cancel_(NULL) {}
 
   // Initialize a map
   Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny, size_t nz,
-          float radius, float height, std::list<Point> fix_pntcloud);
+          float radius, float height, std::list<Point> fix_pntcloud,
+          Connectivity links = LINKS_10);
+
+  // Initialize a map from an occupancy grid (z-index fastest, CellState bits)
+  Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny, size_t nz,
+          float radius, float height, const std::vector<uint8_t> &occupancy,
+          Connectivity links = LINKS_10);
+
+  // Get number of boxes
+  const size_t &nx() const { return nx_; }
+  const size_t &ny() const { return ny_; }
+  const size_t &nz() const { return nz_; }
+  const size_t &n() const { return n_; }
+
+  // Get steps length
+  const float &xstep() const { return xstep_; }
+  const float &ystep() const { return ystep_; }
+  const float &zstep() const { return zstep_; }
+
+  // Get the boxes linked to a box
+  const Connectivity &links() const { return links_; }
+
+  // Get drone dimensions
+  const float &radius() const { return radius_; }
+  const float &height() const { return height_; }
 
   // Get ind-th box
   const Box &boxes(size_t ind) const { return boxes_[ind]; }
   // Get boxes
   const std::vector<Box> &boxes() const { return boxes_; }
+  // Check if a box can be updated with SLAM points
+  bool is_updatable(size_t ind) const { return updatable_[ind]; }
 
   // Set start box from point
   void set_str(const Point &str_pnt);
@@ -69,21 +164,150 @@ public:
 
   // Compute shortest path
   void search();
+  // Compute shortest path on the free cells of a column map
+  void search(const ColumnMap &occ);
   // Set path
   void set_path();
   // Get path
   const std::list<size_t> &path() const { return this->path_; };
 
+  // Enable the integer step costs (fixed point, 1 / COST_SCALE meters)
+  void set_int_cost(bool enable) { int_cost_ = enable; }
+  // Check if the integer step costs are enabled
+  const bool &int_cost() const { return int_cost_; }
+
+  // Fill the heuristic of all boxes in set_trg instead of at first touch,
+  // worth it when many searches share the target
+  void set_h_table(bool enable) {
+    h_table_ = enable;
+    h_trg_ = -1;
+  }
+  // Check if the heuristic table is enabled
+  const bool &h_table() const { return h_table_; }
+
+  // Set a flag that aborts the running search when raised, the search throws
+  // "ERROR: Search cancelled!" (NULL to disable)
+  void set_cancel(const std::atomic<bool> *cancel) { cancel_ = cancel; }
+
+  // Get the counters and the timers, kept only when built with NAV_STATS
+  const PlannerStats &stats() const { return stats_; }
+  // Set the counters and the timers to zero
+  void reset_stats() { stats_.reset(); }
+
+  // Set the margin of the local repair window (negative to disable)
+  void set_repair(int margin) { repair_ = margin; }
+  // Get the margin of the local repair window
+  const int &repair() const { return repair_; }
+
+  // Compute a detour between two boxes inside a bounded window
+  bool search_local(size_t src, size_t dst, std::list<size_t> &detour);
+  // Splice local detours around the blocked segments of the path
+  bool repair_path();
+
   // Update map with SLAM pointcloud
   void update(std::list<Point> slam_pntcloud);
+  // Update map with all the SLAM batches waiting in a queue in one pass,
+  // return the number of slots drained
+  size_t update(ScanQueue &queue);
 
   //
   size_t move();
 
   // Compute the index of the corresponding box
-  size_t pnt_to_ind(const Point &pnt);
+  size_t pnt_to_ind(const Point &pnt) const;
 };
 
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+
+// Build the boxes on a grid with fixed points
+template <class Grid>
+void Planner::build(const Grid &grid, const std::list<Point> &fix_pntcloud) {
+  NAV_STAT(StatTimer timer(this->stats_.build_ms));
+  // Divide the space in boxes
+  this->init_boxes(grid);
+  // Set fixed obstacles
+  this->set_fix_pnts(fix_pntcloud);
+  // Link boxes close to each other
+  this->link_boxes(grid);
+}
+
+// Build the boxes on a grid from an occupancy grid
+template <class Grid>
+void Planner::build(const Grid &grid, const std::vector<uint8_t> &occupancy) {
+  NAV_STAT(StatTimer timer(this->stats_.build_ms));
+  if (occupancy.size() != this->n_)
+    throw "ERROR: Occupancy grid does not match the map size!";
+  // Divide the space in boxes
+  this->init_boxes(grid);
+  // Set fixed obstacles
+  this->set_occupancy(occupancy);
+  // Link boxes close to each other
+  this->link_boxes(grid);
+}
+
+// Divide the space in boxes
+template <class Grid> void Planner::init_boxes(const Grid &grid) {
+  // Compute step
+  this->xstep_ = nav::round(this->xlen_ / (float)this->nx_);
+  this->ystep_ = nav::round(this->ylen_ / (float)this->ny_);
+  this->zstep_ = nav::round(this->zlen_ / (float)this->nz_);
+  // Set the size of the surrounding
+  int xy_level = (int)ceil((this->radius_ - (this->xstep_ / 2)) / this->xstep_);
+  int z_level = (int)ceil((this->height_ - (this->zstep_ / 2)) / this->zstep_);
+  // Divide the space in boxes
+  long x, y, z;
+  std::vector<size_t> neighs;
+  for (size_t ind = 0; ind < this->n_; ind++) {
+    // Set the box index
+    this->boxes_[ind].set_ind(ind);
+    // Set the center of the box
+    grid_sub(grid, ind, x, y, z);
+    float xcnt = nav::round((this->xstep_ * x) + (this->xstep_ / 2));
+    float ycnt = nav::round((this->ystep_ * y) + (this->ystep_ / 2));
+    float zcnt = nav::round((this->zstep_ * z) + (this->zstep_ / 2));
+    Point cnt(xcnt, ycnt, zcnt);
+    this->boxes_[ind].set_cnt(cnt);
+    // Check if the box is inside the space
+    if (((0 <= (xcnt - this->radius_)) &&
+         ((xcnt + this->radius_) <= this->xlen_)) &&
+        ((0 <= (ycnt - this->radius_)) &&
+         ((ycnt + this->radius_) <= this->ylen_)) &&
+        ((0 <= (zcnt - this->height_)) &&
+         ((zcnt + this->height_) <= this->zlen_))) {
+      this->boxes_[ind].set_in();
+    } else {
+      this->boxes_[ind].set_out();
+      this->updatable_[ind] = false;
+    }
+    // Set box neighbors
+    neighs.clear();
+    grid_neighs(grid, ind, xy_level, z_level, neighs);
+    this->boxes_[ind].set_neighs(neighs);
+  }
+}
+
+// Link boxes close to each other
+template <class Grid> void Planner::link_boxes(const Grid &grid) {
+  this->links_ = grid.links();
+  std::vector<size_t> links;
+  for (size_t ind = 0; ind < this->n_; ind++) {
+    if (!this->boxes_[ind].is_free() || !this->boxes_[ind].is_in())
+      continue;
+    // Find links
+    links.clear();
+    grid_links(grid, ind, links);
+    // Set links
+    for (size_t link : links) {
+      if (this->boxes_[link].is_free() && this->boxes_[link].is_in()) {
+        this->boxes_[ind].add_edge(
+            link, this->boxes_[ind].cnt().dist(this->boxes_[link].cnt()));
+      }
+    }
+  }
+}
+
 } // namespace nav
 
 #endif /* PLANNER_H */
\ No newline at end of file
@@ -11,6 +11,11 @@
 /*---------------------------------------------------------------------------*/
 /*                          Standard header includes                         */
 /*---------------------------------------------------------------------------*/
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 107400
+// Boost 1.74 collections use library_version_type without including it
+#include <boost/serialization/library_version_type.hpp>
+#endif
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/list.hpp>
 #include <boost/serialization/vector.hpp>
@@ -86,7 +91,7 @@ public:
   void rotate_xy(const Point &cnt, float theta);
 
   // Check if the point is inside a box
-  bool is_inside_xy(std::vector<Point> &points);
+  bool is_inside_xy(const std::vector<Point> &points) const;
 
   // Check if two points are equals
   bool operator==(const Point &other);
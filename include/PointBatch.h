@@ -0,0 +1,96 @@
+/**
+ * @file PointBatch.h
+ * @brief Header file for the batch geometry kernels
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef POINTBATCH_H
+#define POINTBATCH_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Point.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Coordinates of a set of points in separate arrays
+struct PointArray {
+  std::vector<float> x, y, z;
+
+  // Default constructor
+  PointArray() {}
+  // Initialize from a range of points
+  template <typename It> PointArray(It first, It last) {
+    for (; first != last; first++)
+      push_back(*first);
+  }
+
+  // Get the number of points
+  size_t size() const { return x.size(); }
+  // Remove all the points
+  void clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+  // Add a point
+  void push_back(const Point &pnt) {
+    x.push_back(pnt.x());
+    y.push_back(pnt.y());
+    z.push_back(pnt.z());
+  }
+  // Get a point
+  Point at(size_t i) const { return Point(x[i], y[i], z[i]); }
+};
+
+// Kernels on contiguous coordinates, the results are the same of the Point
+// methods. AVX2 is used when the CPU supports it.
+namespace batch {
+
+// Check if the AVX2 kernels are in use
+bool simd();
+// Enable or disable the AVX2 kernels, ignored if the CPU does not support them
+void set_simd(bool enable);
+
+// Compute the distance of the points from a center, as Point::dist
+void dist(const float *x, const float *y, const float *z, size_t n,
+          const Point &cnt, float *out);
+
+// Compute the xy-distance of the points from a center, as Point::dist_xy
+void dist_xy(const float *x, const float *y, size_t n, const Point &cnt,
+             float *out);
+
+// Flag the points inside a vertical cylinder, as dist_xy <= radius and
+// dist_z <= height, and return their number
+size_t in_cylinder(const float *x, const float *y, const float *z, size_t n,
+                   const Point &cnt, float radius, float height,
+                   uint8_t *out);
+
+// Check if any point is inside a vertical cylinder
+bool any_in_cylinder(const float *x, const float *y, const float *z, size_t n,
+                     const Point &cnt, float radius, float height);
+
+// Flag the points inside a polygon in xy, as Point::is_inside_xy, and return
+// their number
+size_t in_polygon_xy(const float *x, const float *y, size_t n,
+                     const std::vector<Point> &polygon, uint8_t *out);
+
+// Rotate the points of theta on xy-axis, as Point::rotate_xy
+void rotate_xy(float *x, float *y, size_t n, const Point &cnt, float theta);
+
+} // namespace batch
+
+} // namespace nav
+
+#endif /* POINTBATCH_H */
@@ -0,0 +1,69 @@
+/**
+ * @file PointGrid.h
+ * @brief Header file for class PointGrid
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef POINTGRID_H
+#define POINTGRID_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "PointBatch.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Pointcloud bucketed in xy-cells, the points of each cell are sorted along z
+class PointGrid {
+private:
+  float xmin_, ymin_;        // Origin of the grid
+  float res_;                // Side of the cells
+  size_t nx_, ny_;           // Number of cells
+  std::vector<size_t> ofs_;  // First point of each cell, one more at the end
+  std::vector<Point> pnts_;  // Points sorted by cell and z
+  PointArray coords_;        // Coordinates of the sorted points
+
+  // Collect the points of the cells in rows [ix0, ix1) inside the query
+  void query_rows(const std::vector<Point> &polygon, float zmin, float zmax,
+                  size_t ix0, size_t ix1, size_t iy0, size_t iy1,
+                  std::vector<Point> &out) const;
+
+public:
+  // Default constructor
+  PointGrid() : xmin_(0.0f), ymin_(0.0f), res_(1.0f), nx_(0), ny_(0) {}
+
+  // Bucket a pointcloud in cells of the given side
+  PointGrid(const std::vector<Point> &pnts, float res = 1.0f);
+
+  // Get the number of points
+  size_t size() const { return pnts_.size(); }
+  // Get the side of the cells
+  const float &res() const { return res_; }
+  // Get the number of cells
+  const size_t &nx() const { return nx_; }
+  const size_t &ny() const { return ny_; }
+  // Get the points, sorted by cell and z
+  const std::vector<Point> &pnts() const { return pnts_; }
+
+  // Get the points inside a convex polygon in xy and with z in [zmin, zmax]
+  void query(const std::vector<Point> &polygon, float zmin, float zmax,
+             std::vector<Point> &out, size_t n_threads = 1) const;
+
+  // Get the points inside an axis-aligned box
+  void query(const Point &min, const Point &max,
+             std::vector<Point> &out) const;
+};
+
+} // namespace nav
+
+#endif /* POINTGRID_H */
@@ -0,0 +1,93 @@
+/**
+ * @file RadixHeap.h
+ * @brief Header file for class RadixHeap
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Monotone priority queue on integer keys: a pushed key must not be smaller
+// than the last popped one. Bucket i holds the keys whose highest bit that
+// differs from the last popped key is i-1, so push is O(1) and each element
+// moves down at most 32 times.
+template <class V> class RadixHeap {
+private:
+  typedef std::pair<uint32_t, V> Entry;
+  std::vector<Entry> buckets_[33]; // Entries grouped by differing bit
+  uint32_t last_;                  // Last popped key
+  size_t size_;                    // Number of entries
+
+  // Bucket of a key wrt the last popped one
+  size_t bucket(uint32_t key) const {
+    return (key == last_) ? 0 : 32 - __builtin_clz(key ^ last_);
+  }
+
+public:
+  // Initialize an empty queue
+  RadixHeap() : last_(0), size_(0) {}
+
+  // Check if the queue is empty
+  bool empty() const { return size_ == 0; }
+  // Get the number of entries
+  size_t size() const { return size_; }
+
+  // Insert a value, keys below the last popped one are clamped to it
+  void push(uint32_t key, const V &value) {
+    if (key < last_)
+      key = last_;
+    buckets_[bucket(key)].emplace_back(key, value);
+    size_++;
+  }
+
+  // Remove the entry with the minimum key
+  Entry pop() {
+    if (buckets_[0].empty()) {
+      // Redistribute the first non-empty bucket around its minimum
+      size_t i = 1;
+      while (buckets_[i].empty())
+        i++;
+      uint32_t min_key = buckets_[i][0].first;
+      for (const Entry &entry : buckets_[i])
+        min_key = std::min(min_key, entry.first);
+      last_ = min_key;
+      for (const Entry &entry : buckets_[i])
+        buckets_[bucket(entry.first)].push_back(entry);
+      buckets_[i].clear();
+    }
+    Entry entry = buckets_[0].back();
+    buckets_[0].pop_back();
+    size_--;
+    return entry;
+  }
+
+  // Remove all entries
+  void clear() {
+    for (std::vector<Entry> &bucket : buckets_)
+      bucket.clear();
+    last_ = 0;
+    size_ = 0;
+  }
+};
+
+} // namespace nav
+
+#endif /* RADIXHEAP_H */
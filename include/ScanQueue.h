@@ -0,0 +1,74 @@
+/**
+ * @file ScanQueue.h
+ * @brief Header file for class ScanQueue
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef SCANQUEUE_H
+#define SCANQUEUE_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <atomic>
+#include <list>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Point.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Bounded ring of SLAM point batches between one producer thread and one
+// consumer thread. The slots are allocated once, push and pop only copy the
+// points and never lock.
+class ScanQueue {
+private:
+  size_t n_slots_;            // Number of slots
+  size_t slot_size_;          // Points per slot
+  std::vector<Point> pnts_;   // Points of the slots, one after the other
+  std::vector<size_t> sizes_; // Points in each slot
+  // Next slot to pop, written by the consumer only
+  alignas(64) std::atomic<size_t> head_;
+  // Next slot to push, written by the producer only
+  alignas(64) std::atomic<size_t> tail_;
+  // Pushes rejected because the ring was full, written by the producer only
+  alignas(64) std::atomic<size_t> rejected_;
+
+public:
+  // Allocate n_slots slots of slot_size points
+  ScanQueue(size_t n_slots, size_t slot_size);
+  ScanQueue(const ScanQueue &) = delete;
+  ScanQueue &operator=(const ScanQueue &) = delete;
+
+  // Get the number of slots
+  const size_t &n_slots() const { return n_slots_; }
+  // Get the points per slot
+  const size_t &slot_size() const { return slot_size_; }
+  // Get the number of pushes rejected because the ring was full
+  size_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+  // Get the number of slots waiting for the consumer
+  size_t size() const;
+
+  // Producer side. Push a batch of points, spread over as many slots as
+  // needed. The batch is rejected as a whole if the ring cannot hold it.
+  bool push(const Point *pnts, size_t n);
+  bool push(const std::vector<Point> &pnts) {
+    return push(pnts.data(), pnts.size());
+  }
+
+  // Consumer side. Append the points of all the waiting slots, return the
+  // number of slots popped.
+  size_t drain(std::list<Point> &pnts);
+  size_t drain(std::vector<Point> &pnts);
+};
+
+} // namespace nav
+
+#endif /* SCANQUEUE_H */
@@ -0,0 +1,103 @@
+/**
+ * @file Simulator.h
+ * @brief Header file for class Simulator
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Planner.h"
+#include "PointGrid.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Sensor footprint around the drone, in the drone frame
+struct SensorParams {
+  float back;   // Range behind the drone
+  float front;  // Range in front of the drone
+  float side;   // Half width
+  float height; // Half height
+  SensorParams() : back(1.0f), front(3.0f), side(1.0f), height(1.0f) {}
+};
+
+// Start and target of a mission
+struct Mission {
+  Point str;
+  Point trg;
+};
+
+// Outcome of a mission
+struct MissionResult {
+  bool success;                // Target reached
+  std::string error;           // Error message on failure
+  size_t steps;                // Number of moves
+  std::list<size_t> path;      // Visited boxes
+  std::vector<double> step_ms; // Latency of each sense/update step
+  double search_ms;            // Latency of the initial search
+  double total_ms;             // Wall time of the mission
+  PlannerStats stats;          // Counters and timers of the mission
+  MissionResult()
+      : success(false), steps(0), search_ms(0.0), total_ms(0.0) {}
+};
+
+class Simulator {
+private:
+  Planner planner_;                // Planner of the drone
+  const PointGrid *world_;         // World pointcloud (not owned)
+  SensorParams sensor_;            // Sensor footprint
+  float yaw_;                      // Heading of the drone
+  std::vector<Point> bounds_;      // Last sensor footprint
+  std::vector<double> step_ms_;    // Latency of each sense/update step
+
+public:
+  // Initialize a simulator, the world must outlive it
+  Simulator(const Planner &planner, const PointGrid &world,
+            const SensorParams &sensor = SensorParams());
+
+  // Get the planner
+  const Planner &planner() const { return planner_; }
+  // Get the heading
+  const float &yaw() const { return yaw_; }
+  // Get the last sensor footprint
+  const std::vector<Point> &bounds() const { return bounds_; }
+  // Get the latency of each sense/update step
+  const std::vector<double> &step_ms() const { return step_ms_; }
+
+  // Plan from start to target
+  void start(const Point &str, const Point &trg);
+  // Check if the target has been reached
+  bool done() const { return planner_.str() == planner_.trg(); }
+
+  // Sense the points in the footprint and update the planner
+  std::list<Point> sense();
+  // Move to the next box of the path
+  size_t move();
+
+  // Run a mission until the target is reached or max_steps moves are done
+  MissionResult run(const Mission &mission, size_t max_steps);
+};
+
+// Run missions in parallel, each one on its own copy of the planner
+std::vector<MissionResult> run_missions(const Planner &planner,
+                                        const PointGrid &world,
+                                        const std::vector<Mission> &missions,
+                                        size_t n_threads, size_t max_steps,
+                                        const SensorParams &sensor =
+                                            SensorParams());
+
+} // namespace nav
+
+#endif /* SIMULATOR_H */
@@ -0,0 +1,141 @@
+/**
+ * @file Stats.h
+ * @brief Header file for the planner and explorer statistics
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Histogram.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// The counters and the timers are only kept when NAV_STATS is defined,
+// otherwise the statistics stay at zero and cost nothing
+#ifdef NAV_STATS
+#define NAV_STAT(expr) expr
+#else
+#define NAV_STAT(expr)
+#endif
+
+// Elapsed milliseconds since a time point
+inline double elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Add the milliseconds spent in a scope to a total, keep their maximum and
+// record them in a histogram
+class StatTimer {
+private:
+  std::chrono::steady_clock::time_point start_;
+  double *total_ms_;
+  double *max_ms_;
+  LatencyHistogram *hist_;
+
+public:
+  StatTimer(double &total_ms, double *max_ms = NULL,
+            LatencyHistogram *hist = NULL)
+      : start_(std::chrono::steady_clock::now()), total_ms_(&total_ms),
+        max_ms_(max_ms), hist_(hist) {}
+  ~StatTimer() {
+    std::chrono::nanoseconds ns = std::chrono::steady_clock::now() - start_;
+    double ms = ns.count() / 1e6;
+    *total_ms_ += ms;
+    if (max_ms_ != NULL)
+      *max_ms_ = std::max(*max_ms_, ms);
+    if (hist_ != NULL)
+      hist_->record_ns(ns.count());
+  }
+};
+
+// Statistics of a planner, searches and updates include the failed ones
+struct PlannerStats {
+  double build_ms;              // Building the map in the constructor
+  size_t searches;              // Global searches
+  size_t failures;              // Global searches without a path or cancelled
+  size_t expanded;              // Boxes expanded by the global searches
+  size_t pushes;                // Heap insertions of the global searches
+  size_t decrease_keys;         // Heap decrease-keys of the global searches
+  size_t stale;                 // Outdated heap entries popped and skipped
+  double search_ms;             // Time in the global searches
+  double search_max_ms;         // Slowest global search
+  size_t updates;               // Calls to update
+  size_t slam_pnts;             // SLAM points given to update
+  size_t new_busy;              // Boxes set busy by update
+  size_t blocked;               // Updates that found the path blocked
+  size_t repairs;               // Paths fixed by local detours
+  size_t local_expanded;        // Boxes expanded by the local searches
+  size_t researches;            // Global searches triggered by update
+  double update_ms;             // Time in update, repair and search included
+  double update_max_ms;         // Slowest update
+  double repair_ms;             // Time in the local repairs
+  LatencyHistogram search_hist; // Latency of the global searches
+  LatencyHistogram update_hist; // Latency of update
+
+  PlannerStats() { reset(); }
+  // Set all the statistics to zero
+  void reset() {
+    build_ms = search_ms = search_max_ms = 0.0;
+    update_ms = update_max_ms = repair_ms = 0.0;
+    searches = failures = expanded = pushes = decrease_keys = stale = 0;
+    updates = slam_pnts = new_busy = blocked = repairs = local_expanded = 0;
+    researches = 0;
+    search_hist.reset();
+    update_hist.reset();
+  }
+  // Add the statistics of another planner, the maxima are merged
+  void add(const PlannerStats &other);
+  // Write the statistics as a JSON object
+  std::string to_json() const;
+};
+
+// Statistics of an explorer
+struct ExplorerStats {
+  double build_ms;      // Building the map in the constructor
+  size_t explored;      // Boxes set explored
+  size_t field_inits;   // Full rebuilds of the frontier distance field
+  size_t field_repairs; // Lazy repairs of the frontier distance field
+  size_t field_raised;  // Boxes raised by the repairs
+  size_t field_pops;    // Boxes popped while lowering the field
+  double field_ms;      // Time in the rebuilds and the repairs
+  size_t sat_builds;    // Builds of the information gain table
+  double sat_ms;        // Time in the builds of the table
+  size_t goals;         // Calls to next_goal
+  double goal_ms;       // Time in next_goal, field repair included
+  size_t views;         // Calls to next_view
+  size_t view_expanded; // Boxes expanded by next_view
+  size_t view_cands;    // Frontier boxes scored by next_view
+  double view_ms;       // Time in next_view
+
+  ExplorerStats() { reset(); }
+  // Set all the statistics to zero
+  void reset() {
+    build_ms = field_ms = sat_ms = goal_ms = view_ms = 0.0;
+    explored = field_inits = field_repairs = field_raised = field_pops = 0;
+    sat_builds = goals = views = view_expanded = view_cands = 0;
+  }
+  // Write the statistics as a JSON object
+  std::string to_json() const;
+};
+
+} // namespace nav
+
+#endif /* STATS_H */
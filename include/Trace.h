@@ -0,0 +1,95 @@
+/**
+ * @file Trace.h
+ * @brief Header file for the timeline trace of the planning sessions
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Scoped events are recorded in a buffer of the calling thread and written
+// as a Chrome trace JSON file, readable by Perfetto or chrome://tracing. The
+// names and the argument keys must be string literals. Like the statistics,
+// the events are only compiled with NAV_STATS.
+#ifdef NAV_STATS
+#define NAV_TRACE(name) nav::TraceScope nav_trace_(name)
+#define NAV_TRACE_ARG(key, value) nav_trace_.arg(key, value)
+#else
+#define NAV_TRACE(name)
+#define NAV_TRACE_ARG(key, value)
+#endif
+
+namespace trace {
+
+// Flag of the recording, checked by each event
+extern std::atomic<bool> enabled_;
+
+// Check if the events are recorded
+inline bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+// Start recording the events
+void start();
+// Stop recording the events
+void stop();
+// Write the events recorded between the last start and stop, return their
+// number
+size_t write(const std::string &path);
+// Drop all the recorded events, no traced thread must be running
+void clear();
+
+// Get the nanoseconds since the first use of the trace
+uint64_t now_ns();
+// Name the calling thread in the trace
+void set_thread_name(const std::string &name);
+// Record a complete event of the calling thread
+void record(const char *name, uint64_t ts_ns, uint64_t dur_ns,
+            const char *const *keys, const int64_t *vals, size_t n_args);
+
+} // namespace trace
+
+// Event covering the lifetime of the object, with up to two integer
+// arguments. Nothing is read from the clock while the recording is off.
+class TraceScope {
+private:
+  const char *name_;
+  bool on_;
+  uint64_t start_ns_;
+  const char *keys_[2];
+  int64_t vals_[2];
+  size_t n_args_;
+
+public:
+  TraceScope(const char *name)
+      : name_(name), on_(trace::enabled()), start_ns_(0), n_args_(0) {
+    if (on_)
+      start_ns_ = trace::now_ns();
+  }
+  ~TraceScope() {
+    if (on_)
+      trace::record(name_, start_ns_, trace::now_ns() - start_ns_, keys_,
+                    vals_, n_args_);
+  }
+  // Attach an argument to the event, the extra ones are ignored
+  void arg(const char *key, int64_t value) {
+    if (n_args_ < 2) {
+      keys_[n_args_] = key;
+      vals_[n_args_++] = value;
+    }
+  }
+};
+
+} // namespace nav
+
+#endif /* TRACE_H */
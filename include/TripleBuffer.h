@@ -0,0 +1,70 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Header file for class TripleBuffer
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <atomic>
+#include <cstdint>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Latest value shared by one writer thread and one reader thread. The writer
+// fills its back slot and publishes it, the reader takes the last published
+// one. Neither side ever waits, the values not read in time are skipped.
+template <class T> class TripleBuffer {
+private:
+  static const uint8_t FRESH = 4; // Set on the middle slot until read
+
+  T slots_[3]; // Values, each owned by one side or in the middle
+  // Slot exchanged between the two sides, with the FRESH bit
+  alignas(64) std::atomic<uint8_t> middle_;
+  // Slot filled by the writer
+  alignas(64) uint8_t back_;
+  // Slot read by the reader
+  alignas(64) uint8_t front_;
+
+public:
+  // Initialize the slots with default values
+  TripleBuffer() : middle_(1), back_(0), front_(2) {}
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  // Writer side. Get the slot to fill, it holds an old value that must be
+  // overwritten as a whole.
+  T &back() { return slots_[back_]; }
+  // Writer side. Publish the back slot and take the middle one as the new
+  // back slot.
+  void publish() {
+    back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & 3;
+  }
+
+  // Reader side. Take the last published value, false if nothing was
+  // published since the last call.
+  bool update() {
+    if (!(middle_.load(std::memory_order_relaxed) & FRESH))
+      return false;
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & 3;
+    return true;
+  }
+  // Reader side. Get the value taken by the last update.
+  const T &front() const { return slots_[front_]; }
+};
+
+} // namespace nav
+
+#endif /* TRIPLEBUFFER_H */
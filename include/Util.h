@@ -28,6 +28,9 @@ typedef std::pair<size_t, float> WtEdge;
 
 #define INF 1000000000.0f
 
+// Fixed-point scale of the integer step costs
+#define COST_SCALE 10000.0
+
 // Convert three-dimensional indexes into a linear index according to the given
 // size
 size_t sub_to_ind_xy(std::vector<size_t> &size, std::vector<size_t> &idxs);
@@ -0,0 +1,92 @@
+/**
+ * @file WorldGen.h
+ * @brief Header file for class WorldGen
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+#ifndef WORLDGEN_H
+#define WORLDGEN_H
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cstdint>
+#include <random>
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Point.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Axis-aligned obstacle given by its opposite corners
+typedef std::pair<Point, Point> Obstacle;
+
+// Kind of world
+enum WorldKind {
+  WORLD_OFFICE,     // Rooms with doors and desks
+  WORLD_WAREHOUSE,  // Rows of racks with shelves and pallets
+  WORLD_FOREST,     // Trunks and canopies
+  WORLD_MULTISTOREY // Office floors stacked on slabs with stairwells
+};
+
+// Parameters of a world
+struct WorldParams {
+  WorldKind kind;     // Kind of world
+  float xlen;         // World dimension
+  float ylen;
+  float zlen;
+  unsigned seed;      // Random seed
+  float density;      // Clutter density in [0, 1]
+  float storey;       // Height of a storey
+  WorldParams()
+      : kind(WORLD_OFFICE), xlen(20.0f), ylen(10.0f), zlen(3.0f), seed(0),
+        density(0.5f), storey(3.0f) {}
+};
+
+class WorldGen {
+private:
+  WorldParams params_;              // World parameters
+  std::vector<Obstacle> obstacles_; // Generated obstacles
+  std::mt19937 rng_;                // Random generator
+
+  // Add an obstacle clipped to the world
+  void add(float x0, float y0, float z0, float x1, float y1, float z1);
+  // Draw a random value in [lo, hi)
+  float uniform(float lo, float hi);
+
+  // Generate the kinds of world
+  void gen_office(float z0, float z1);
+  void gen_warehouse();
+  void gen_forest();
+  void gen_multistorey();
+
+public:
+  // Generate a world
+  WorldGen(const WorldParams &params);
+
+  // Get parameters
+  const WorldParams &params() const { return params_; }
+  // Get obstacles
+  const std::vector<Obstacle> &obstacles() const { return obstacles_; }
+
+  // Sample the surfaces of the obstacles with the given resolution
+  std::vector<Point> pntcloud(float res, size_t n_threads = 1) const;
+
+  // Rasterize the obstacles on a grid (z-index fastest, CellState bits)
+  std::vector<uint8_t> occupancy(size_t nx, size_t ny, size_t nz,
+                                 size_t n_threads = 1) const;
+};
+
+// Convert the name of a world kind
+WorldKind world_kind(const std::string &name);
+
+} // namespace nav
+
+#endif /* WORLDGEN_H */
@@ -0,0 +1,624 @@
+/**
+ * @file CloudFile.cpp
+ * @brief Source file for class CloudFile
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "CloudFile.h"
+#include "Trace.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Convert a float into a half float (round to nearest, flush subnormals)
+static uint16_t float_to_half(float val) {
+  uint32_t bits;
+  memcpy(&bits, &val, sizeof(bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  int32_t exp = ((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mant = bits & 0x7fffff;
+  if (((bits >> 23) & 0xff) == 0xff)
+    return sign | 0x7c00 | (mant ? 0x200 : 0);
+  if (exp <= 0)
+    return sign;
+  if (exp >= 31)
+    return sign | 0x7c00;
+  uint32_t half = sign | (exp << 10) | (mant >> 13);
+  if ((mant & 0x1fff) > 0x1000 || ((mant & 0x1fff) == 0x1000 && (half & 1)))
+    half++;
+  return half;
+}
+
+// Convert a half float into a float
+static float half_to_float(uint16_t half) {
+  uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  uint32_t exp = (half >> 10) & 0x1f;
+  uint32_t mant = half & 0x3ff;
+  uint32_t bits;
+  if (exp == 0)
+    bits = sign;
+  else if (exp == 31)
+    bits = sign | 0x7f800000 | (mant << 13);
+  else
+    bits = sign | ((exp - 15 + 127) << 23) | (mant << 13);
+  float val;
+  memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+// Size in bytes of an encoded coordinate
+static size_t coord_size(uint32_t encoding) {
+  return (encoding == CLOUD_F32) ? sizeof(float) : sizeof(uint16_t);
+}
+
+// Spread the lower 10 bits of a value for a Morton code
+static uint32_t spread_bits(uint32_t val) {
+  val &= 0x3ff;
+  val = (val | (val << 16)) & 0x030000ff;
+  val = (val | (val << 8)) & 0x0300f00f;
+  val = (val | (val << 4)) & 0x030c30c3;
+  val = (val | (val << 2)) & 0x09249249;
+  return val;
+}
+
+// Map a file in memory
+CloudFile::CloudFile(const std::string &path)
+    : fd_(-1), size_(0), data_(NULL) {
+  // Open file
+  this->fd_ = open(path.c_str(), O_RDONLY);
+  if (this->fd_ < 0)
+    throw "ERROR: Cannot open cloud file!";
+  struct stat st;
+  if (fstat(this->fd_, &st) < 0 || (size_t)st.st_size < sizeof(CloudHeader)) {
+    close(this->fd_);
+    throw "ERROR: Cloud file is truncated!";
+  }
+  this->size_ = st.st_size;
+  // Map file
+  void *data = mmap(NULL, this->size_, PROT_READ, MAP_PRIVATE, this->fd_, 0);
+  if (data == MAP_FAILED) {
+    close(this->fd_);
+    throw "ERROR: Cannot map cloud file!";
+  }
+  this->data_ = (const char *)data;
+  // Check header
+  const CloudHeader &hdr = this->header();
+  const char *err = NULL;
+  if (hdr.magic != CLOUD_MAGIC)
+    err = "ERROR: Not a cloud file!";
+  else if (hdr.version != CLOUD_VERSION)
+    err = "ERROR: Unsupported cloud file version!";
+  else if (hdr.encoding > CLOUD_Q16 || hdr.table_ofs > this->size_ ||
+           hdr.n_chunks > (this->size_ - hdr.table_ofs) / sizeof(CloudChunk))
+    err = "ERROR: Cloud file is corrupted!";
+  // The chunks must lie within the file and hold all the points
+  uint64_t n_pnts = 0;
+  for (size_t i = 0; err == NULL && i < hdr.n_chunks; i++) {
+    const CloudChunk &chk = this->chunk(i);
+    size_t pnt_size = 3 * coord_size(hdr.encoding);
+    if (chk.ofs > this->size_ ||
+        chk.count > (this->size_ - chk.ofs) / pnt_size ||
+        chk.count > hdr.n_pnts - n_pnts)
+      err = "ERROR: Cloud file is corrupted!";
+    else
+      n_pnts += chk.count;
+  }
+  if (err == NULL && n_pnts != hdr.n_pnts)
+    err = "ERROR: Cloud file is corrupted!";
+  if (err != NULL) {
+    munmap((void *)this->data_, this->size_);
+    close(this->fd_);
+    throw err;
+  }
+}
+
+// Unmap the file
+CloudFile::~CloudFile() {
+  munmap((void *)this->data_, this->size_);
+  close(this->fd_);
+}
+
+// Decode the coordinates of the i-th chunk
+void CloudFile::decode(size_t i, float *x, float *y, float *z) const {
+  const CloudChunk &chk = this->chunk(i);
+  const char *col = this->data_ + chk.ofs;
+  float *dst[3] = {x, y, z};
+  switch (this->header().encoding) {
+  case CLOUD_F32:
+    for (size_t k = 0; k < 3; k++)
+      memcpy(dst[k], col + k * chk.count * sizeof(float),
+             chk.count * sizeof(float));
+    break;
+  case CLOUD_F16:
+    for (size_t k = 0; k < 3; k++) {
+      const uint16_t *src =
+          (const uint16_t *)(col + k * chk.count * sizeof(uint16_t));
+      for (size_t j = 0; j < chk.count; j++)
+        dst[k][j] = half_to_float(src[j]);
+    }
+    break;
+  case CLOUD_Q16:
+    for (size_t k = 0; k < 3; k++) {
+      const uint16_t *src =
+          (const uint16_t *)(col + k * chk.count * sizeof(uint16_t));
+      float scale = (chk.max[k] - chk.min[k]) / 65535.0f;
+      for (size_t j = 0; j < chk.count; j++)
+        dst[k][j] = chk.min[k] + scale * src[j];
+    }
+    break;
+  }
+}
+
+// Read all points
+void CloudFile::read(std::vector<Point> &pntcloud) const {
+  NAV_TRACE("CloudFile::read");
+  std::vector<float> x, y, z;
+  pntcloud.reserve(pntcloud.size() + this->header().n_pnts);
+  for (size_t i = 0; i < this->n_chunks(); i++) {
+    size_t count = this->chunk(i).count;
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    this->decode(i, x.data(), y.data(), z.data());
+    for (size_t j = 0; j < count; j++)
+      pntcloud.emplace_back(x[j], y[j], z[j]);
+  }
+}
+void CloudFile::read(std::list<Point> &pntcloud) const {
+  std::vector<Point> pnts;
+  this->read(pnts);
+  pntcloud.insert(pntcloud.end(), pnts.begin(), pnts.end());
+}
+
+// Read the points inside an axis-aligned box, skipping the other chunks
+void CloudFile::read(const Point &min, const Point &max,
+                     std::vector<Point> &pntcloud) const {
+  NAV_TRACE("CloudFile::read");
+  std::vector<float> x, y, z;
+  for (size_t i = 0; i < this->n_chunks(); i++) {
+    const CloudChunk &chk = this->chunk(i);
+    // Skip chunks outside the box
+    if (chk.max[0] < min.x() || chk.min[0] > max.x() || chk.max[1] < min.y() ||
+        chk.min[1] > max.y() || chk.max[2] < min.z() || chk.min[2] > max.z())
+      continue;
+    x.resize(chk.count);
+    y.resize(chk.count);
+    z.resize(chk.count);
+    this->decode(i, x.data(), y.data(), z.data());
+    for (size_t j = 0; j < chk.count; j++) {
+      if (min.x() <= x[j] && x[j] <= max.x() && min.y() <= y[j] &&
+          y[j] <= max.y() && min.z() <= z[j] && z[j] <= max.z())
+        pntcloud.emplace_back(x[j], y[j], z[j]);
+    }
+  }
+}
+
+// Write a point cloud
+void CloudFile::write(const std::string &path,
+                      const std::vector<Point> &pntcloud,
+                      CloudEncoding encoding, size_t chunk_size) {
+  NAV_TRACE("CloudFile::write");
+  if (chunk_size == 0)
+    throw "ERROR: Chunk size must be positive!";
+  // Header
+  CloudHeader hdr;
+  memset(&hdr, 0, sizeof(CloudHeader));
+  hdr.magic = CLOUD_MAGIC;
+  hdr.version = CLOUD_VERSION;
+  hdr.encoding = encoding;
+  hdr.chunk_size = chunk_size;
+  hdr.n_pnts = pntcloud.size();
+  hdr.n_chunks = (pntcloud.size() + chunk_size - 1) / chunk_size;
+  // Cloud bounding box
+  for (size_t k = 0; k < 3; k++) {
+    hdr.min[k] = pntcloud.empty() ? 0.0f : INF;
+    hdr.max[k] = pntcloud.empty() ? 0.0f : -INF;
+  }
+  for (const Point &pnt : pntcloud) {
+    float c[3] = {pnt.x(), pnt.y(), pnt.z()};
+    for (size_t k = 0; k < 3; k++) {
+      hdr.min[k] = std::min(hdr.min[k], c[k]);
+      hdr.max[k] = std::max(hdr.max[k], c[k]);
+    }
+  }
+  // Sort points along a Morton curve so that chunks are spatially compact
+  std::vector<std::pair<uint32_t, size_t>> order(pntcloud.size());
+  for (size_t i = 0; i < pntcloud.size(); i++) {
+    const Point &pnt = pntcloud[i];
+    float c[3] = {pnt.x(), pnt.y(), pnt.z()};
+    uint32_t code = 0;
+    for (size_t k = 0; k < 3; k++) {
+      float ext = hdr.max[k] - hdr.min[k];
+      uint32_t q = (ext > 0.0f) ? (uint32_t)((c[k] - hdr.min[k]) / ext * 1023)
+                                : 0;
+      code |= spread_bits(q) << k;
+    }
+    order[i] = std::make_pair(code, i);
+  }
+  std::sort(order.begin(), order.end());
+  // Chunks
+  size_t csize = coord_size(encoding);
+  uint64_t ofs = (sizeof(CloudHeader) + CLOUD_ALIGN - 1) / CLOUD_ALIGN *
+                 CLOUD_ALIGN;
+  hdr.table_ofs = ofs;
+  ofs += (hdr.n_chunks * sizeof(CloudChunk) + CLOUD_ALIGN - 1) / CLOUD_ALIGN *
+         CLOUD_ALIGN;
+  std::vector<CloudChunk> table(hdr.n_chunks);
+  std::vector<char> cols;
+  for (size_t i = 0; i < hdr.n_chunks; i++) {
+    CloudChunk &chk = table[i];
+    size_t first = i * chunk_size;
+    chk.count = std::min(chunk_size, pntcloud.size() - first);
+    chk.ofs = ofs + cols.size();
+    // Chunk bounding box
+    for (size_t k = 0; k < 3; k++) {
+      chk.min[k] = INF;
+      chk.max[k] = -INF;
+    }
+    for (size_t j = 0; j < chk.count; j++) {
+      const Point &pnt = pntcloud[order[first + j].second];
+      float c[3] = {pnt.x(), pnt.y(), pnt.z()};
+      for (size_t k = 0; k < 3; k++) {
+        chk.min[k] = std::min(chk.min[k], c[k]);
+        chk.max[k] = std::max(chk.max[k], c[k]);
+      }
+    }
+    // Encode columns
+    size_t base = cols.size();
+    cols.resize(base + 3 * chk.count * csize);
+    for (size_t k = 0; k < 3; k++) {
+      char *col = cols.data() + base + k * chk.count * csize;
+      float ext = chk.max[k] - chk.min[k];
+      for (size_t j = 0; j < chk.count; j++) {
+        const Point &pnt = pntcloud[order[first + j].second];
+        float c = (k == 0) ? pnt.x() : ((k == 1) ? pnt.y() : pnt.z());
+        if (encoding == CLOUD_F32) {
+          memcpy(col + j * csize, &c, csize);
+        } else {
+          uint16_t val = (encoding == CLOUD_F16)
+                             ? float_to_half(c)
+                             : (uint16_t)(ext > 0.0f ? (c - chk.min[k]) /
+                                                               ext * 65535 +
+                                                           0.5f
+                                                     : 0);
+          memcpy(col + j * csize, &val, csize);
+        }
+      }
+    }
+    // Align next chunk
+    cols.resize((cols.size() + CLOUD_ALIGN - 1) / CLOUD_ALIGN * CLOUD_ALIGN);
+    // Shrink the bounding box on the decoded values
+    if (encoding == CLOUD_F16) {
+      for (size_t k = 0; k < 3; k++) {
+        chk.min[k] = half_to_float(float_to_half(chk.min[k]));
+        chk.max[k] = half_to_float(float_to_half(chk.max[k]));
+      }
+    }
+  }
+  // Write file
+  std::ofstream ofs_file(path, std::ios::binary | std::ios::trunc);
+  if (!ofs_file)
+    throw "ERROR: Cannot open cloud file for writing!";
+  std::vector<char> pad(CLOUD_ALIGN, 0);
+  ofs_file.write((const char *)&hdr, sizeof(CloudHeader));
+  ofs_file.write(pad.data(), hdr.table_ofs - sizeof(CloudHeader));
+  ofs_file.write((const char *)table.data(),
+                 table.size() * sizeof(CloudChunk));
+  ofs_file.write(pad.data(), (CLOUD_ALIGN - (table.size() * sizeof(CloudChunk)) %
+                                                CLOUD_ALIGN) %
+                                 CLOUD_ALIGN);
+  ofs_file.write(cols.data(), cols.size());
+  if (!ofs_file)
+    throw "ERROR: Cannot write cloud file!";
+}
+void CloudFile::write(const std::string &path,
+                      const std::list<Point> &pntcloud,
+                      CloudEncoding encoding, size_t chunk_size) {
+  std::vector<Point> pnts(pntcloud.begin(), pntcloud.end());
+  CloudFile::write(path, pnts, encoding, chunk_size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                 Importers                                 */
+/*---------------------------------------------------------------------------*/
+
+// Scalar property of a record
+struct Field {
+  std::string name; // Property name
+  char type;        // 'F' float, 'I' signed, 'U' unsigned
+  size_t size;      // Size in bytes
+  size_t ofs;       // Offset in the record
+};
+
+// Check if a field has a type and a size that can be decoded
+static bool is_valid(const Field &fld) {
+  if (fld.type == 'F')
+    return fld.size == 4 || fld.size == 8;
+  return (fld.type == 'I' || fld.type == 'U') &&
+         (fld.size == 1 || fld.size == 2 || fld.size == 4 || fld.size == 8);
+}
+
+// Decode a scalar value
+static double read_field(const char *src, const Field &fld, bool swap) {
+  char buf[8];
+  memcpy(buf, src, fld.size);
+  if (swap)
+    std::reverse(buf, buf + fld.size);
+  switch (fld.type) {
+  case 'F':
+    if (fld.size == 4) {
+      float val;
+      memcpy(&val, buf, 4);
+      return val;
+    } else {
+      double val;
+      memcpy(&val, buf, 8);
+      return val;
+    }
+  case 'I':
+    if (fld.size == 1)
+      return *(int8_t *)buf;
+    if (fld.size == 2)
+      return *(int16_t *)buf;
+    if (fld.size == 4)
+      return *(int32_t *)buf;
+    return *(int64_t *)buf;
+  default:
+    if (fld.size == 1)
+      return *(uint8_t *)buf;
+    if (fld.size == 2)
+      return *(uint16_t *)buf;
+    if (fld.size == 4)
+      return *(uint32_t *)buf;
+    return *(uint64_t *)buf;
+  }
+}
+
+// Find the x, y, z fields of a record
+static void find_xyz(const std::vector<Field> &flds, size_t xyz[3]) {
+  const char *names[3] = {"x", "y", "z"};
+  for (size_t k = 0; k < 3; k++) {
+    xyz[k] = flds.size();
+    for (size_t i = 0; i < flds.size(); i++) {
+      if (flds[i].name == names[k])
+        xyz[k] = i;
+    }
+    if (xyz[k] == flds.size())
+      throw "ERROR: Point cloud has no x, y, z fields!";
+  }
+}
+
+// Number of bytes left in a stream
+static size_t remaining(std::istream &is) {
+  std::streampos pos = is.tellg();
+  is.seekg(0, std::ios::end);
+  std::streampos end = is.tellg();
+  is.seekg(pos);
+  return (pos < 0 || end < pos) ? 0 : (size_t)(end - pos);
+}
+
+// Stream fixed-size binary records
+static void read_records(std::istream &is, size_t n, size_t rec_size,
+                         const std::vector<Field> &flds, bool swap,
+                         std::vector<Point> &pntcloud) {
+  size_t xyz[3];
+  find_xyz(flds, xyz);
+  // The header count must fit in the rest of the file
+  if (n > 0 && (rec_size == 0 || n > remaining(is) / rec_size))
+    throw "ERROR: Point cloud is truncated!";
+  const size_t batch = 65536;
+  std::vector<char> buf(std::min(batch, n) * rec_size);
+  pntcloud.reserve(pntcloud.size() + n);
+  for (size_t done = 0; done < n;) {
+    size_t cnt = std::min(batch, n - done);
+    if (!is.read(buf.data(), cnt * rec_size))
+      throw "ERROR: Point cloud is truncated!";
+    for (size_t i = 0; i < cnt; i++) {
+      const char *rec = buf.data() + i * rec_size;
+      float c[3];
+      for (size_t k = 0; k < 3; k++)
+        c[k] = read_field(rec + flds[xyz[k]].ofs, flds[xyz[k]], swap);
+      if (std::isfinite(c[0]) && std::isfinite(c[1]) && std::isfinite(c[2]))
+        pntcloud.emplace_back(c[0], c[1], c[2]);
+    }
+    done += cnt;
+  }
+}
+
+// Stream ascii records
+static void read_ascii(std::istream &is, size_t n,
+                       const std::vector<Field> &flds,
+                       std::vector<Point> &pntcloud) {
+  size_t xyz[3];
+  find_xyz(flds, xyz);
+  std::vector<double> vals(flds.size());
+  std::string line;
+  // Each record takes at least one byte of the rest of the file
+  pntcloud.reserve(pntcloud.size() + std::min(n, remaining(is)));
+  for (size_t i = 0; i < n; i++) {
+    if (!std::getline(is, line))
+      throw "ERROR: Point cloud is truncated!";
+    std::istringstream ls(line);
+    for (size_t j = 0; j < flds.size(); j++) {
+      std::string tok;
+      ls >> tok;
+      vals[j] = strtod(tok.c_str(), NULL);
+    }
+    float c[3] = {(float)vals[xyz[0]], (float)vals[xyz[1]],
+                  (float)vals[xyz[2]]};
+    if (std::isfinite(c[0]) && std::isfinite(c[1]) && std::isfinite(c[2]))
+      pntcloud.emplace_back(c[0], c[1], c[2]);
+  }
+}
+
+// Convert a PLY type name
+static bool ply_type(const std::string &name, char &type, size_t &size) {
+  static const char *names[] = {"char",   "int8",    "uchar",   "uint8",
+                                "short",  "int16",   "ushort",  "uint16",
+                                "int",    "int32",   "uint",    "uint32",
+                                "float",  "float32", "double",  "float64"};
+  static const char types[] = "IIUUIIUUIIUUFFFF";
+  static const size_t sizes[] = {1, 1, 1, 1, 2, 2, 2, 2,
+                                 4, 4, 4, 4, 4, 4, 8, 8};
+  for (size_t i = 0; i < 16; i++) {
+    if (name == names[i]) {
+      type = types[i];
+      size = sizes[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+// Import the vertices of a PLY file
+void import_ply(const std::string &path, std::vector<Point> &pntcloud) {
+  std::ifstream is(path, std::ios::binary);
+  if (!is)
+    throw "ERROR: Cannot open PLY file!";
+  std::string line, tok;
+  if (!std::getline(is, line) || line.compare(0, 3, "ply") != 0)
+    throw "ERROR: Not a PLY file!";
+  // Parse header
+  std::string format;
+  bool in_vertex = false, before_vertex = true;
+  size_t n = 0, skip_lines = 0;
+  std::vector<Field> flds;
+  size_t rec_size = 0;
+  while (std::getline(is, line)) {
+    std::istringstream ls(line);
+    ls >> tok;
+    if (tok == "format") {
+      ls >> format;
+    } else if (tok == "element") {
+      std::string name;
+      size_t count;
+      ls >> name >> count;
+      if (in_vertex)
+        before_vertex = false;
+      in_vertex = (name == "vertex");
+      if (in_vertex)
+        n = count;
+      else if (before_vertex)
+        skip_lines += count;
+    } else if (tok == "property") {
+      std::string type, name;
+      ls >> type;
+      // Binary records before the vertices cannot be skipped blindly
+      if (!in_vertex && before_vertex && format != "ascii")
+        throw "ERROR: PLY binary elements before vertices are not supported!";
+      if (type == "list") {
+        if (in_vertex)
+          throw "ERROR: PLY list properties on vertices are not supported!";
+        continue;
+      }
+      ls >> name;
+      Field fld;
+      if (!ply_type(type, fld.type, fld.size))
+        throw "ERROR: Unknown PLY property type!";
+      if (in_vertex) {
+        fld.name = name;
+        fld.ofs = rec_size;
+        rec_size += fld.size;
+        flds.push_back(fld);
+      }
+    } else if (tok == "end_header") {
+      break;
+    }
+  }
+  // Read vertices
+  if (format == "ascii") {
+    for (size_t i = 0; i < skip_lines; i++)
+      std::getline(is, line);
+    read_ascii(is, n, flds, pntcloud);
+  } else if (format == "binary_little_endian" ||
+             format == "binary_big_endian") {
+    read_records(is, n, rec_size, flds, format == "binary_big_endian",
+                 pntcloud);
+  } else {
+    throw "ERROR: Unknown PLY format!";
+  }
+}
+
+// Import the points of a PCD file
+void import_pcd(const std::string &path, std::vector<Point> &pntcloud) {
+  std::ifstream is(path, std::ios::binary);
+  if (!is)
+    throw "ERROR: Cannot open PCD file!";
+  // Parse header
+  std::string line, tok, data;
+  std::vector<Field> flds;
+  std::vector<size_t> counts;
+  size_t n = 0;
+  while (data.empty() && std::getline(is, line)) {
+    std::istringstream ls(line);
+    ls >> tok;
+    if (tok == "FIELDS") {
+      while (ls >> tok) {
+        Field fld;
+        fld.name = tok;
+        fld.type = 'F';
+        fld.size = 4;
+        flds.push_back(fld);
+      }
+    } else if (tok == "SIZE") {
+      for (Field &fld : flds)
+        ls >> fld.size;
+    } else if (tok == "TYPE") {
+      for (Field &fld : flds)
+        ls >> fld.type;
+    } else if (tok == "COUNT") {
+      size_t count;
+      while (ls >> count)
+        counts.push_back(count);
+    } else if (tok == "POINTS") {
+      ls >> n;
+    } else if (tok == "DATA") {
+      ls >> data;
+    }
+  }
+  for (const Field &fld : flds) {
+    if (!is_valid(fld))
+      throw "ERROR: Unsupported PCD field type or size!";
+  }
+  counts.resize(flds.size(), 1);
+  // Expand fields with count > 1 and compute offsets
+  std::vector<Field> recs;
+  size_t rec_size = 0;
+  for (size_t i = 0; i < flds.size(); i++) {
+    for (size_t j = 0; j < counts[i]; j++) {
+      Field fld = flds[i];
+      if (j > 0)
+        fld.name += "_" + std::to_string(j);
+      fld.ofs = rec_size;
+      rec_size += fld.size;
+      recs.push_back(fld);
+    }
+  }
+  // Read points
+  if (data == "ascii")
+    read_ascii(is, n, recs, pntcloud);
+  else if (data == "binary")
+    read_records(is, n, rec_size, recs, false, pntcloud);
+  else
+    throw "ERROR: Unsupported PCD data format!";
+}
+
+} // namespace nav
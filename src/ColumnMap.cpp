@@ -0,0 +1,123 @@
+/**
+ * @file ColumnMap.cpp
+ * @brief Source file for class ColumnMap
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "ColumnMap.h"
+#include "Planner.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Find the run containing the z-index
+static std::vector<Run>::const_iterator find_run(const std::vector<Run> &col,
+                                                 size_t iz) {
+  return std::upper_bound(
+             col.begin(), col.end(), iz,
+             [](size_t z, const Run &run) { return z < run.z; }) -
+         1;
+}
+
+// Initialize a map with all cells in the same state
+ColumnMap::ColumnMap(size_t nx, size_t ny, size_t nz, uint8_t state)
+    : nx_(nx), ny_(ny), nz_(nz), cols_(nx * ny, {Run{0, state}}) {}
+
+// Initialize a map from a dense grid
+ColumnMap::ColumnMap(size_t nx, size_t ny, size_t nz,
+                     const std::vector<uint8_t> &dense)
+    : nx_(nx), ny_(ny), nz_(nz), cols_(nx * ny) {
+  if (dense.size() != nx * ny * nz)
+    throw "ERROR: Dense grid does not match the map size!";
+  // Columns are contiguous since the z-index is the fastest one
+  for (size_t col = 0; col < this->cols_.size(); col++) {
+    const uint8_t *cells = dense.data() + col * nz;
+    for (size_t iz = 0; iz < nz; iz++) {
+      if (iz == 0 || cells[iz] != cells[iz - 1])
+        this->cols_[col].push_back(Run{(uint32_t)iz, cells[iz]});
+    }
+    this->cols_[col].shrink_to_fit();
+  }
+}
+
+// Initialize a map from the boxes of a planner
+ColumnMap::ColumnMap(const Planner &planner)
+    : nx_(planner.nx()), ny_(planner.ny()), nz_(planner.nz()),
+      cols_(nx_ * ny_) {
+  for (size_t col = 0; col < this->cols_.size(); col++) {
+    uint8_t prev = 0;
+    for (size_t iz = 0; iz < this->nz_; iz++) {
+      const Box &box = planner.boxes(col * this->nz_ + iz);
+      uint8_t state =
+          (box.is_in() ? CELL_IN : 0) | (box.is_free() ? CELL_FREE : 0);
+      if (iz == 0 || state != prev)
+        this->cols_[col].push_back(Run{(uint32_t)iz, state});
+      prev = state;
+    }
+    this->cols_[col].shrink_to_fit();
+  }
+}
+
+// Convert the map in a dense grid
+std::vector<uint8_t> ColumnMap::to_dense() const {
+  std::vector<uint8_t> dense(this->nx_ * this->ny_ * this->nz_);
+  for (size_t col = 0; col < this->cols_.size(); col++) {
+    const std::vector<Run> &runs = this->cols_[col];
+    for (size_t i = 0; i < runs.size(); i++) {
+      size_t end = (i + 1 < runs.size()) ? runs[i + 1].z : this->nz_;
+      std::fill(dense.begin() + col * this->nz_ + runs[i].z,
+                dense.begin() + col * this->nz_ + end, runs[i].state);
+    }
+  }
+  return dense;
+}
+
+// Get the state of a cell
+uint8_t ColumnMap::state(size_t ix, size_t iy, size_t iz) const {
+  return find_run(this->cols_[iy + this->ny_ * ix], iz)->state;
+}
+
+// Set the state of a cell
+void ColumnMap::set(size_t ix, size_t iy, size_t iz, uint8_t state) {
+  std::vector<Run> &col = this->cols_[iy + this->ny_ * ix];
+  size_t i = find_run(col, iz) - col.begin();
+  if (col[i].state == state)
+    return;
+  size_t end = (i + 1 < col.size()) ? col[i + 1].z : this->nz_;
+  // Split the run in (before, cell, after)
+  std::vector<Run> split;
+  if (col[i].z < iz)
+    split.push_back(Run{col[i].z, col[i].state});
+  split.push_back(Run{(uint32_t)iz, state});
+  if (iz + 1 < end)
+    split.push_back(Run{(uint32_t)iz + 1, col[i].state});
+  col.erase(col.begin() + i);
+  col.insert(col.begin() + i, split.begin(), split.end());
+  // Merge with the adjacent runs
+  size_t j = i + (col[i].z < iz ? 1 : 0);
+  if (j + 1 < col.size() && col[j + 1].state == state)
+    col.erase(col.begin() + j + 1);
+  if (j > 0 && col[j - 1].state == state)
+    col.erase(col.begin() + j);
+}
+
+// Get the total number of runs
+size_t ColumnMap::n_runs() const {
+  size_t n = 0;
+  for (const std::vector<Run> &col : this->cols_)
+    n += col.size();
+  return n;
+}
+
+} // namespace nav
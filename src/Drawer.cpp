@@ -5,6 +5,12 @@
  * @author Alessandro Tenaglia
  */
 
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <utility>
+
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
@@ -116,9 +122,10 @@ void draw_circle(float radius) {
 }
 
 void draw_cylinder(float x, float y, float z, float radius, float height) {
+  // One quadric for all the calls
+  static GLUquadricObj *quadratic = gluNewQuadric();
   glPushMatrix();
   glTranslatef(x, y, z);
-  GLUquadricObj *quadratic = gluNewQuadric();
   glPushMatrix();
   glTranslatef(0.0, 0.0, -height);
   draw_circle(radius);
@@ -160,4 +167,239 @@ void draw_polyhedron(const nav::Point &p1, const nav::Point &p2,
                 p4.z() + height);
 }
 
+MeshBuffer::MeshBuffer(GLenum mode)
+    : mode_(mode), vbo_(0), capacity_(0), uploaded_(0) {}
+
+MeshBuffer::MeshBuffer(MeshBuffer &&other)
+    : mode_(other.mode_), vbo_(other.vbo_), capacity_(other.capacity_),
+      uploaded_(other.uploaded_), data_(std::move(other.data_)) {
+  other.vbo_ = 0;
+  other.capacity_ = other.uploaded_ = 0;
+}
+
+MeshBuffer::~MeshBuffer() {
+  if (this->vbo_ != 0)
+    glDeleteBuffers(1, &this->vbo_);
+}
+
+void MeshBuffer::clear() {
+  this->data_.clear();
+  this->uploaded_ = 0;
+}
+
+void MeshBuffer::add_point(const nav::Point &pnt) {
+  this->data_.insert(this->data_.end(), {pnt.x(), pnt.y(), pnt.z()});
+}
+
+void MeshBuffer::add_link(const nav::Point &src, const nav::Point &dst) {
+  this->add_point(src);
+  this->add_point(dst);
+}
+
+void MeshBuffer::add_box(const nav::Point &cnt, float xlen, float ylen,
+                         float zlen) {
+  // Corners, the bits of the index select the max side along x, y and z
+  GLfloat cor[8][3];
+  for (int i = 0; i < 8; i++) {
+    cor[i][0] = cnt.x() + ((i & 1) ? xlen : -xlen) / 2;
+    cor[i][1] = cnt.y() + ((i & 2) ? ylen : -ylen) / 2;
+    cor[i][2] = cnt.z() + ((i & 4) ? zlen : -zlen) / 2;
+  }
+  // Faces as quads of corners
+  static const int faces[6][4] = {{0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4},
+                                  {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5}};
+  for (const int *face : faces) {
+    for (int k : {0, 1, 2, 0, 2, 3})
+      this->data_.insert(this->data_.end(), cor[face[k]], cor[face[k]] + 3);
+  }
+}
+
+void MeshBuffer::add_cylinder(const nav::Point &cnt, float radius,
+                              float height) {
+  const int sides = 20;
+  float zb = cnt.z() - height, zt = cnt.z() + height;
+  for (int i = 0; i < sides; i++) {
+    double th0 = 2 * M_PI * i / sides, th1 = 2 * M_PI * (i + 1) / sides;
+    float x0 = cnt.x() + cos(th0) * radius, y0 = cnt.y() + sin(th0) * radius;
+    float x1 = cnt.x() + cos(th1) * radius, y1 = cnt.y() + sin(th1) * radius;
+    this->data_.insert(this->data_.end(),
+                       {// Side
+                        x0, y0, zb, x1, y1, zb, x1, y1, zt, //
+                        x0, y0, zb, x1, y1, zt, x0, y0, zt, //
+                        // Bottom and top caps
+                        cnt.x(), cnt.y(), zb, x0, y0, zb, x1, y1, zb, //
+                        cnt.x(), cnt.y(), zt, x0, y0, zt, x1, y1, zt});
+  }
+}
+
+void MeshBuffer::draw() {
+  size_t n = this->size();
+  if (n == 0)
+    return;
+  if (this->vbo_ == 0)
+    glGenBuffers(1, &this->vbo_);
+  glBindBuffer(GL_ARRAY_BUFFER, this->vbo_);
+  if (n > this->capacity_) {
+    // Grow geometrically, the whole data is uploaded again
+    this->capacity_ = std::max(n, 2 * this->capacity_);
+    glBufferData(GL_ARRAY_BUFFER, this->capacity_ * 3 * sizeof(GLfloat), NULL,
+                 GL_DYNAMIC_DRAW);
+    this->uploaded_ = 0;
+  }
+  if (this->uploaded_ < n) {
+    // Upload only the new range
+    glBufferSubData(GL_ARRAY_BUFFER, this->uploaded_ * 3 * sizeof(GLfloat),
+                    (n - this->uploaded_) * 3 * sizeof(GLfloat),
+                    this->data_.data() + this->uploaded_ * 3);
+    this->uploaded_ = n;
+  }
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, GL_FLOAT, 0, NULL);
+  glDrawArrays(this->mode_, 0, (GLsizei)n);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Frustum::update() {
+  GLfloat p[16], m[16], c[16];
+  glGetFloatv(GL_PROJECTION_MATRIX, p);
+  glGetFloatv(GL_MODELVIEW_MATRIX, m);
+  // Clip matrix, column-major as in GL
+  for (int col = 0; col < 4; col++) {
+    for (int row = 0; row < 4; row++) {
+      c[col * 4 + row] = 0.0f;
+      for (int k = 0; k < 4; k++)
+        c[col * 4 + row] += p[k * 4 + row] * m[col * 4 + k];
+    }
+  }
+  // Left, right, bottom, top, near and far planes from the rows
+  for (int i = 0; i < 6; i++) {
+    int row = i / 2;
+    float sign = (i % 2) ? -1.0f : 1.0f;
+    for (int col = 0; col < 4; col++)
+      this->planes_[i][col] = c[col * 4 + 3] + sign * c[col * 4 + row];
+  }
+  // Camera as the inverse of the rigid modelview
+  for (int i = 0; i < 3; i++)
+    this->eye_[i] = -(m[i * 4 + 0] * m[12] + m[i * 4 + 1] * m[13] +
+                      m[i * 4 + 2] * m[14]);
+}
+
+bool Frustum::intersects(const float *min, const float *max) const {
+  // Outside if the corner furthest along a plane normal is behind it
+  for (const float *plane : this->planes_) {
+    float dist = plane[3];
+    for (int k = 0; k < 3; k++)
+      dist += plane[k] * (plane[k] >= 0.0f ? max[k] : min[k]);
+    if (dist < 0.0f)
+      return false;
+  }
+  return true;
+}
+
+float Frustum::distance(const float *min, const float *max) const {
+  float dist = 0.0f;
+  for (int k = 0; k < 3; k++) {
+    float delta = std::max(std::max(min[k] - this->eye_[k], 0.0f),
+                           this->eye_[k] - max[k]);
+    dist += delta * delta;
+  }
+  return std::sqrt(dist);
+}
+
+ChunkGrid::Chunk::Chunk(GLenum mode)
+    : min{INFINITY, INFINITY, INFINITY}, max{-INFINITY, -INFINITY, -INFINITY},
+      fine(mode), coarse(mode) {}
+
+ChunkGrid::ChunkGrid(GLenum mode, float xlen, float ylen, float chunk_len,
+                     float cell_len, float lod_dist)
+    : chunk_len_(chunk_len), cell_len_(cell_len),
+      lod_dist_(lod_dist), drawn_(0) {
+  if (chunk_len <= 0.0f || cell_len <= 0.0f)
+    throw "ERROR: Chunk and cell sides must be positive!";
+  this->nx_ = std::max((size_t)std::ceil(xlen / chunk_len), (size_t)1);
+  this->ny_ = std::max((size_t)std::ceil(ylen / chunk_len), (size_t)1);
+  this->chunks_.reserve(this->nx_ * this->ny_);
+  for (size_t i = 0; i < this->nx_ * this->ny_; i++)
+    this->chunks_.emplace_back(mode);
+}
+
+ChunkGrid::Chunk &ChunkGrid::chunk(const nav::Point &pnt) {
+  long ix = (long)std::floor(pnt.x() / this->chunk_len_);
+  long iy = (long)std::floor(pnt.y() / this->chunk_len_);
+  ix = std::min(std::max(ix, 0L), (long)this->nx_ - 1);
+  iy = std::min(std::max(iy, 0L), (long)this->ny_ - 1);
+  return this->chunks_[iy + this->ny_ * ix];
+}
+
+bool ChunkGrid::new_cell(Chunk &chunk, const nav::Point &pnt) {
+  // 21 bits per axis, enough for any map in cells
+  const int64_t off = 1 << 20, mask = (1 << 21) - 1;
+  int64_t ix = (int64_t)std::floor(pnt.x() / this->cell_len_);
+  int64_t iy = (int64_t)std::floor(pnt.y() / this->cell_len_);
+  int64_t iz = (int64_t)std::floor(pnt.z() / this->cell_len_);
+  int64_t key = (((ix + off) & mask) << 42) | (((iy + off) & mask) << 21) |
+                ((iz + off) & mask);
+  return chunk.cells.insert(key).second;
+}
+
+nav::Point ChunkGrid::cell_cnt(const nav::Point &pnt) const {
+  return nav::Point(
+      (std::floor(pnt.x() / this->cell_len_) + 0.5f) * this->cell_len_,
+      (std::floor(pnt.y() / this->cell_len_) + 0.5f) * this->cell_len_,
+      (std::floor(pnt.z() / this->cell_len_) + 0.5f) * this->cell_len_);
+}
+
+void ChunkGrid::extend(Chunk &chunk, const nav::Point &cnt, float xlen,
+                       float ylen, float zlen) {
+  const float pos[3] = {cnt.x(), cnt.y(), cnt.z()};
+  const float len[3] = {xlen, ylen, zlen};
+  for (int k = 0; k < 3; k++) {
+    chunk.min[k] = std::min(chunk.min[k], pos[k] - len[k] / 2);
+    chunk.max[k] = std::max(chunk.max[k], pos[k] + len[k] / 2);
+  }
+}
+
+void ChunkGrid::add_point(const nav::Point &pnt) {
+  Chunk &chunk = this->chunk(pnt);
+  extend(chunk, pnt, 0.0f, 0.0f, 0.0f);
+  chunk.fine.add_point(pnt);
+  // The first point of each cell stands for the others
+  if (this->new_cell(chunk, pnt))
+    chunk.coarse.add_point(pnt);
+}
+
+void ChunkGrid::add_link(const nav::Point &src, const nav::Point &dst) {
+  Chunk &chunk = this->chunk(src);
+  extend(chunk, src, 0.0f, 0.0f, 0.0f);
+  extend(chunk, dst, 0.0f, 0.0f, 0.0f);
+  chunk.fine.add_link(src, dst);
+}
+
+void ChunkGrid::add_box(const nav::Point &cnt, float xlen, float ylen,
+                        float zlen) {
+  Chunk &chunk = this->chunk(cnt);
+  extend(chunk, cnt, xlen, ylen, zlen);
+  chunk.fine.add_box(cnt, xlen, ylen, zlen);
+  // The boxes of a cell are merged in the whole cell
+  if (this->new_cell(chunk, cnt)) {
+    nav::Point cell_cnt = this->cell_cnt(cnt);
+    extend(chunk, cell_cnt, this->cell_len_, this->cell_len_, this->cell_len_);
+    chunk.coarse.add_box(cell_cnt, this->cell_len_, this->cell_len_,
+                         this->cell_len_);
+  }
+}
+
+void ChunkGrid::draw(const Frustum &frustum) {
+  this->drawn_ = 0;
+  for (Chunk &chunk : this->chunks_) {
+    if (chunk.fine.size() == 0 || !frustum.intersects(chunk.min, chunk.max))
+      continue;
+    bool far = frustum.distance(chunk.min, chunk.max) > this->lod_dist_;
+    MeshBuffer &mesh = far ? chunk.coarse : chunk.fine;
+    mesh.draw();
+    this->drawn_ += mesh.size();
+  }
+}
+
 } // namespace gl
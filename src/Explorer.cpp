@@ -5,6 +5,12 @@
  * @author Alessandro Tenaglia
  */
 
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cmath>
+#include <thread>
+
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
@@ -20,6 +26,7 @@ Explorer::Explorer(float xlen, float ylen, size_t nx, size_t ny, float radius,
                    std::list<Point> exp_fix_pntcloud)
     : xlen_(xlen), ylen_(ylen), nx_(nx), ny_(ny), n_(nx * ny), radius_(radius),
       boxes_(n_) {
+  NAV_STAT(StatTimer timer(this->stats_.build_ms));
   // Compute step
   this->xstep_ = nav::round(xlen / (float)nx);
   this->ystep_ = nav::round(ylen / (float)ny);
@@ -81,6 +88,360 @@ Explorer::Explorer(float xlen, float ylen, size_t nx, size_t ny, float radius,
   }
 }
 
+// Rebuild the frontier and its distance field from the explored flags
+void Explorer::init_frontier() {
+  NAV_TRACE("Explorer::init_frontier");
+  NAV_STAT(StatTimer timer(this->stats_.field_ms));
+  NAV_STAT(this->stats_.field_inits++);
+  this->frontier_.clear();
+  this->frontier_pos_.assign(this->n_, -1);
+  this->fdist_.assign(this->n_, INF);
+  this->fnext_.assign(this->n_, -1);
+  this->fsrc_.assign(this->n_, -1);
+  this->pending_.clear();
+  // Multi-source Dijkstra from all the frontier boxes
+  NodeQueue OPEN;
+  for (size_t ind = 0; ind < this->n_; ind++) {
+    if (!this->boxes_[ind].is_explored())
+      continue;
+    for (const WtEdge &edge : this->boxes_[ind].edges()) {
+      if (this->add_frontier(edge.first))
+        OPEN.push(Node(edge.first, 0.0f));
+    }
+  }
+  this->propagate(OPEN);
+}
+
+// Add a box to the frontier as a source of the distance field
+bool Explorer::add_frontier(size_t ind) {
+  if (this->frontier_pos_[ind] != (size_t)-1 ||
+      this->boxes_[ind].is_explored() || !this->boxes_[ind].is_free())
+    return false;
+  this->frontier_pos_[ind] = this->frontier_.size();
+  this->frontier_.push_back(ind);
+  this->fdist_[ind] = 0.0f;
+  this->fnext_[ind] = ind;
+  this->fsrc_[ind] = ind;
+  return true;
+}
+
+// Remove a box from the frontier, the last one takes its place
+void Explorer::rm_frontier(size_t ind) {
+  size_t pos = this->frontier_pos_[ind];
+  if (pos == (size_t)-1)
+    return;
+  this->frontier_[pos] = this->frontier_.back();
+  this->frontier_pos_[this->frontier_[pos]] = pos;
+  this->frontier_.pop_back();
+  this->frontier_pos_[ind] = -1;
+}
+
+// Lower the distance field from the boxes in the queue, only explored boxes
+// are known to be traversable
+void Explorer::propagate(NodeQueue &OPEN) {
+  while (!OPEN.empty()) {
+    Node curr = OPEN.top();
+    OPEN.pop();
+    NAV_STAT(this->stats_.field_pops++);
+    if (curr.f() > this->fdist_[curr.ind()])
+      continue;
+    for (const WtEdge &edge : this->boxes_[curr.ind()].edges()) {
+      if (!this->boxes_[edge.first].is_explored())
+        continue;
+      float dist = this->fdist_[curr.ind()] + edge.second;
+      if (dist >= this->fdist_[edge.first])
+        continue;
+      this->fdist_[edge.first] = dist;
+      this->fnext_[edge.first] = curr.ind();
+      this->fsrc_[edge.first] = this->fsrc_[curr.ind()];
+      OPEN.push(Node(edge.first, dist));
+    }
+  }
+}
+
+// Set a box as explored and update the frontier, the distance field is
+// repaired when next queried
+void Explorer::set_explored(size_t ind) {
+  if (this->boxes_[ind].is_explored())
+    return;
+  if (this->frontier_pos_.size() != this->n_)
+    this->init_frontier();
+  NAV_STAT(this->stats_.explored++);
+  this->boxes_[ind].set_explored();
+  for (const WtEdge &edge : this->boxes_[ind].edges()) {
+    this->boxes_[edge.first].set_f(this->boxes_[edge.first].f() - 1);
+    this->add_frontier(edge.first);
+  }
+  this->rm_frontier(ind);
+  this->pending_.push_back(ind);
+  this->sat_.clear();
+}
+
+// Set the free boxes in the view of a box as explored
+void Explorer::set_explored(size_t ind, float range) {
+  size_t hx = (size_t)(range / this->xstep_);
+  size_t hy = (size_t)(range / this->ystep_);
+  size_t ix = ind / this->ny_, iy = ind % this->ny_;
+  size_t x1 = std::min(ix + hx + 1, this->nx_);
+  size_t y1 = std::min(iy + hy + 1, this->ny_);
+  for (size_t x = (ix > hx) ? ix - hx : 0; x < x1; x++) {
+    for (size_t y = (iy > hy) ? iy - hy : 0; y < y1; y++) {
+      if (this->boxes_[y + this->ny_ * x].is_free())
+        this->set_explored(y + this->ny_ * x);
+    }
+  }
+}
+
+// Repair the distance field around the boxes explored since the last update
+void Explorer::update_field() {
+  if (this->frontier_pos_.size() != this->n_) {
+    this->init_frontier();
+    return;
+  }
+  if (this->pending_.empty())
+    return;
+  NAV_TRACE("Explorer::update_field");
+  NAV_STAT(StatTimer timer(this->stats_.field_ms));
+  NAV_STAT(this->stats_.field_repairs++);
+  // Raise the explored boxes and the ones whose closest frontier box has been
+  // explored, these are linked to them along the next boxes
+  std::vector<size_t> raised;
+  for (size_t ind : this->pending_) {
+    this->fdist_[ind] = INF;
+    this->fnext_[ind] = -1;
+    this->fsrc_[ind] = -1;
+    raised.push_back(ind);
+  }
+  for (size_t i = 0; i < raised.size(); i++) {
+    for (const WtEdge &edge : this->boxes_[raised[i]].edges()) {
+      size_t src = this->fsrc_[edge.first];
+      if (src == (size_t)-1 || !this->boxes_[src].is_explored())
+        continue;
+      this->fdist_[edge.first] = INF;
+      this->fnext_[edge.first] = -1;
+      this->fsrc_[edge.first] = -1;
+      raised.push_back(edge.first);
+    }
+  }
+  NAV_STAT(this->stats_.field_raised += raised.size());
+  NAV_TRACE_ARG("raised", raised.size());
+  // Lower from the new frontier boxes and from the neighbors of the raised
+  // boxes still in the field
+  NodeQueue OPEN;
+  for (size_t ind : this->pending_) {
+    for (const WtEdge &edge : this->boxes_[ind].edges()) {
+      if (this->frontier_pos_[edge.first] != (size_t)-1)
+        OPEN.push(Node(edge.first, 0.0f));
+    }
+  }
+  for (size_t box : raised) {
+    for (const WtEdge &edge : this->boxes_[box].edges()) {
+      if (this->fsrc_[edge.first] == (size_t)-1)
+        continue;
+      float dist = this->fdist_[edge.first] + edge.second;
+      if (dist < this->fdist_[box]) {
+        this->fdist_[box] = dist;
+        this->fnext_[box] = edge.first;
+        this->fsrc_[box] = this->fsrc_[edge.first];
+      }
+    }
+    if (this->fsrc_[box] != (size_t)-1)
+      OPEN.push(Node(box, this->fdist_[box]));
+  }
+  this->pending_.clear();
+  this->propagate(OPEN);
+}
+
+// Build the summed-area table of the unexplored free boxes, the entry (x, y)
+// counts the boxes with smaller indexes on both axes
+void Explorer::build_sat() {
+  NAV_TRACE("Explorer::build_sat");
+  NAV_STAT(StatTimer timer(this->stats_.sat_ms));
+  NAV_STAT(this->stats_.sat_builds++);
+  size_t ny1 = this->ny_ + 1;
+  this->sat_.assign((this->nx_ + 1) * ny1, 0);
+  for (size_t x = 0; x < this->nx_; x++) {
+    uint32_t row = 0;
+    for (size_t y = 0; y < this->ny_; y++) {
+      const ExpBox &box = this->boxes_[y + this->ny_ * x];
+      row += (box.is_free() && !box.is_explored()) ? 1 : 0;
+      this->sat_[(x + 1) * ny1 + y + 1] = this->sat_[x * ny1 + y + 1] + row;
+    }
+  }
+}
+
+// Count the unexplored free boxes in the view of a box from the table
+size_t Explorer::sat_gain(size_t ind, size_t hx, size_t hy) const {
+  size_t ny1 = this->ny_ + 1;
+  size_t ix = ind / this->ny_, iy = ind % this->ny_;
+  size_t x0 = (ix > hx) ? ix - hx : 0, x1 = std::min(ix + hx + 1, this->nx_);
+  size_t y0 = (iy > hy) ? iy - hy : 0, y1 = std::min(iy + hy + 1, this->ny_);
+  return this->sat_[x1 * ny1 + y1] - this->sat_[x0 * ny1 + y1] -
+         this->sat_[x1 * ny1 + y0] + this->sat_[x0 * ny1 + y0];
+}
+
+// Count the unexplored free boxes in the view of a box
+size_t Explorer::info_gain(size_t ind, float range) {
+  if (this->sat_.empty())
+    this->build_sat();
+  return this->sat_gain(ind, (size_t)(range / this->xstep_),
+                        (size_t)(range / this->ystep_));
+}
+
+// Count the unexplored free boxes in the view of each box, the boxes are
+// split among the threads
+void Explorer::info_gain(const std::vector<size_t> &inds, float range,
+                         std::vector<size_t> &gains, size_t n_threads) {
+  if (this->sat_.empty())
+    this->build_sat();
+  size_t hx = (size_t)(range / this->xstep_);
+  size_t hy = (size_t)(range / this->ystep_);
+  gains.resize(inds.size());
+  n_threads = std::max((size_t)1, std::min(n_threads, inds.size()));
+  auto count = [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; i++)
+      gains[i] = this->sat_gain(inds[i], hx, hy);
+  };
+  if (n_threads == 1) {
+    count(0, inds.size());
+    return;
+  }
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < n_threads; t++) {
+    workers.emplace_back(count, t * inds.size() / n_threads,
+                         (t + 1) * inds.size() / n_threads);
+  }
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+// Group the frontier boxes in connected clusters
+std::vector<std::vector<size_t>> Explorer::frontier_clusters() {
+  if (this->frontier_pos_.size() != this->n_)
+    this->init_frontier();
+  std::vector<std::vector<size_t>> clusters;
+  std::vector<bool> visited(this->frontier_.size(), false);
+  for (size_t i = 0; i < this->frontier_.size(); i++) {
+    if (visited[i])
+      continue;
+    // Flood fill on the links between frontier boxes
+    clusters.emplace_back();
+    std::vector<size_t> stack = {this->frontier_[i]};
+    visited[i] = true;
+    while (!stack.empty()) {
+      size_t ind = stack.back();
+      stack.pop_back();
+      clusters.back().push_back(ind);
+      for (const WtEdge &edge : this->boxes_[ind].edges()) {
+        size_t pos = this->frontier_pos_[edge.first];
+        if (pos != (size_t)-1 && !visited[pos]) {
+          visited[pos] = true;
+          stack.push_back(edge.first);
+        }
+      }
+    }
+  }
+  return clusters;
+}
+
+// Compute the path to the closest frontier box
+bool Explorer::next_goal(size_t curr_ind, std::list<size_t> &path) {
+  NAV_TRACE("Explorer::next_goal");
+  NAV_STAT(StatTimer timer(this->stats_.goal_ms));
+  NAV_STAT(this->stats_.goals++);
+  if (this->frontier_pos_.size() != this->n_)
+    this->init_frontier();
+  path.clear();
+  if (this->frontier_.empty())
+    return false;
+  // Frontier boxes next to the current one need no search
+  size_t min_score = -1, min_ind = -1;
+  float min_dist = INF;
+  for (const WtEdge &edge : this->boxes_[curr_ind].edges()) {
+    if (this->frontier_pos_[edge.first] == (size_t)-1)
+      continue;
+    size_t score = this->boxes_[edge.first].f();
+    if (score < min_score || (score == min_score && edge.second < min_dist)) {
+      min_score = score;
+      min_dist = edge.second;
+      min_ind = edge.first;
+    }
+  }
+  if (min_ind != (size_t)-1) {
+    path.push_back(min_ind);
+    return true;
+  }
+  // Otherwise follow the distance field down to the closest frontier box
+  this->update_field();
+  if (this->fsrc_[curr_ind] == (size_t)-1)
+    return false;
+  for (size_t ind = this->fnext_[curr_ind]; ind != this->fsrc_[curr_ind];
+       ind = this->fnext_[ind])
+    path.push_back(ind);
+  path.push_back(this->fsrc_[curr_ind]);
+  return true;
+}
+
+// Compute the path to the frontier box with the best view
+bool Explorer::next_view(size_t curr_ind, float range, float lambda,
+                         std::list<size_t> &path, size_t n_threads) {
+  NAV_TRACE("Explorer::next_view");
+  NAV_STAT(StatTimer timer(this->stats_.view_ms));
+  NAV_STAT(this->stats_.views++);
+  if (this->frontier_pos_.size() != this->n_)
+    this->init_frontier();
+  path.clear();
+  // Dijkstra through the explored boxes to all the reachable frontier boxes
+  std::vector<float> dist(this->n_, INF);
+  std::vector<size_t> pred(this->n_, -1);
+  std::vector<size_t> cands;
+  NodeQueue OPEN;
+  dist[curr_ind] = 0.0f;
+  OPEN.push(Node(curr_ind, 0.0f));
+  while (!OPEN.empty()) {
+    Node curr = OPEN.top();
+    OPEN.pop();
+    if (curr.f() > dist[curr.ind()])
+      continue;
+    NAV_STAT(this->stats_.view_expanded++);
+    if (curr.ind() != curr_ind &&
+        this->frontier_pos_[curr.ind()] != (size_t)-1)
+      cands.push_back(curr.ind());
+    if (curr.ind() != curr_ind && !this->boxes_[curr.ind()].is_explored())
+      continue;
+    for (const WtEdge &edge : this->boxes_[curr.ind()].edges()) {
+      float next = dist[curr.ind()] + edge.second;
+      if (next >= dist[edge.first])
+        continue;
+      dist[edge.first] = next;
+      pred[edge.first] = curr.ind();
+      OPEN.push(Node(edge.first, next));
+    }
+  }
+  // Score the candidates in log space, so far ones do not underflow. They
+  // are popped by increasing distance so ties go to the closest one.
+  NAV_STAT(this->stats_.view_cands += cands.size());
+  NAV_TRACE_ARG("cands", cands.size());
+  std::vector<size_t> gains;
+  this->info_gain(cands, range, gains, n_threads);
+  size_t best = -1;
+  float best_score = -INF;
+  for (size_t i = 0; i < cands.size(); i++) {
+    if (gains[i] == 0)
+      continue;
+    float score = std::log((float)gains[i]) - lambda * dist[cands[i]];
+    if (score > best_score) {
+      best_score = score;
+      best = cands[i];
+    }
+  }
+  if (best == (size_t)-1)
+    return false;
+  for (size_t ind = best; ind != curr_ind; ind = pred[ind])
+    path.push_front(ind);
+  return true;
+}
+
 // Compute the index of the corresponding box
 size_t Explorer::pnt_to_ind(const Point &pnt) {
   // Point idxs
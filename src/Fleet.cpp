@@ -0,0 +1,316 @@
+/**
+ * @file Fleet.cpp
+ * @brief Source file for class Fleet
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Fleet.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Remove all the reservations
+void ReservationTable::clear() {
+  this->cells_.clear();
+  this->last_.clear();
+  this->parked_.clear();
+}
+
+// Reserve a box at a time
+void ReservationTable::reserve(size_t ind, size_t t) {
+  this->cells_.insert(t * this->n_ + ind);
+  size_t &last = this->last_.emplace(ind, t).first->second;
+  last = std::max(last, t);
+}
+
+// Reserve a box from a time on
+void ReservationTable::park(size_t ind, size_t t) {
+  size_t &from = this->parked_.emplace(ind, t).first->second;
+  from = std::min(from, t);
+}
+
+// Initialize an empty fleet on a map
+Fleet::Fleet(const Planner &map, size_t window, size_t n_threads)
+    : map_(&map), window_(window), n_threads_(std::max(n_threads, (size_t)1)),
+      table_(map.n()), time_(0), planned_(-1), failures_(0), kept_(0) {
+  if (window < 2)
+    throw "ERROR: Fleet window must be at least 2 steps!";
+  // Two drones collide when their bodies overlap, that is when their centers
+  // are closer than two radii on the plane and two heights along z
+  long lx = (long)ceil(2 * map.radius() / map.xstep());
+  long ly = (long)ceil(2 * map.radius() / map.ystep());
+  long lz = (long)ceil(2 * map.height() / map.zstep());
+  for (long dx = -lx; dx <= lx; dx++) {
+    for (long dy = -ly; dy <= ly; dy++) {
+      for (long dz = -lz; dz <= lz; dz++) {
+        float x = dx * map.xstep(), y = dy * map.ystep(), z = dz * map.zstep();
+        if (sqrt(x * x + y * y) < 2 * map.radius() &&
+            fabs(z) < 2 * map.height())
+          this->offsets_.push_back({dx, dy, dz});
+      }
+    }
+  }
+}
+
+// Check if two drones centered in two boxes collide
+bool Fleet::collide(size_t a, size_t b) const {
+  const Point &pa = this->map_->boxes(a).cnt();
+  const Point &pb = this->map_->boxes(b).cnt();
+  float dx = pa.x() - pb.x(), dy = pa.y() - pb.y();
+  return sqrt(dx * dx + dy * dy) < 2 * this->map_->radius() &&
+         fabs(pa.z() - pb.z()) < 2 * this->map_->height();
+}
+
+// Add a drone between two points
+size_t Fleet::add_agent(const Point &str, const Point &trg) {
+  size_t str_ind = this->map_->pnt_to_ind(str);
+  size_t trg_ind = this->map_->pnt_to_ind(trg);
+  if (str_ind >= this->map_->n() || trg_ind >= this->map_->n())
+    throw "ERROR: Agent point is out of map!";
+  const Box &str_box = this->map_->boxes(str_ind);
+  const Box &trg_box = this->map_->boxes(trg_ind);
+  if (!str_box.is_free() || !str_box.is_in() || !trg_box.is_free() ||
+      !trg_box.is_in())
+    throw "ERROR: Agent box is not free!";
+  // Drones may neither start nor stop inside each other
+  for (const Agent &agent : this->agents_) {
+    if (this->collide(str_ind, agent.str) || this->collide(trg_ind, agent.trg))
+      throw "ERROR: Agents are too close!";
+  }
+  Agent agent(str_ind, trg_ind);
+  this->fill_dist(agent);
+  if (agent.dist[str_ind] == UINT32_MAX)
+    throw "ERROR: Agent target is not reachable!";
+  this->agents_.push_back(agent);
+  // The new drone is planned at the next step
+  this->planned_ = -1;
+  return this->agents_.size() - 1;
+}
+
+// Fill the steps to the target of a drone on the free boxes, breadth-first
+// from the target since the links go both ways
+void Fleet::fill_dist(Agent &agent) const {
+  agent.dist.assign(this->map_->n(), UINT32_MAX);
+  std::vector<size_t> queue(1, agent.trg);
+  agent.dist[agent.trg] = 0;
+  for (size_t head = 0; head < queue.size(); head++) {
+    size_t curr = queue[head];
+    for (const WtEdge &edge : this->map_->boxes(curr).edges()) {
+      const Box &link = this->map_->boxes(edge.first);
+      if (!link.is_free() || !link.is_in() ||
+          agent.dist[edge.first] != UINT32_MAX)
+        continue;
+      agent.dist[edge.first] = agent.dist[curr] + 1;
+      queue.push_back(edge.first);
+    }
+  }
+}
+
+// Search the plan of a drone in space-time, away from the boxes held by the
+// other drones and from the reservations. Each step costs one, waiting
+// included, so the cost of a state is its time and the first visit of a
+// state is final. The steps to the target ignoring the other drones are a
+// consistent heuristic, hence the keys popped never decrease.
+bool Fleet::search(const Agent &agent, std::vector<size_t> &plan) const {
+  const size_t n = this->map_->n();
+  RadixHeap<uint64_t> OPEN;
+  std::unordered_map<uint64_t, uint64_t> pred;
+  // Boxes held by the drone itself, the ones of the others are off limits
+  std::vector<size_t> own;
+  this->hit(agent.str, own);
+  // States are keyed by time * n + box, the start is at time zero
+  uint64_t start = agent.str;
+  pred.emplace(start, start);
+  OPEN.push(agent.dist[agent.str], start);
+  while (!OPEN.empty()) {
+    uint64_t key = OPEN.pop().second;
+    size_t t = key / n, ind = key % n;
+    // The target ends the search if the drone can stay there, the end of the
+    // window ends it anyway and the next plans go on from there
+    if ((ind == agent.trg && this->table_.is_free_from(ind, t)) ||
+        t == this->window_) {
+      plan.clear();
+      for (uint64_t k = key; k != start; k = pred[k])
+        plan.push_back(k % n);
+      plan.push_back(agent.str);
+      std::reverse(plan.begin(), plan.end());
+      return true;
+    }
+    // Wait in the box or move to a linked one
+    auto visit = [&](size_t next) {
+      uint64_t next_key = (t + 1) * n + next;
+      if ((this->stays_[next] > 0 &&
+           this->stays_[next] > std::count(own.begin(), own.end(), next)) ||
+          !this->table_.is_free(next, t + 1) ||
+          !pred.emplace(next_key, key).second)
+        return;
+      OPEN.push(t + 1 + agent.dist[next], next_key);
+    };
+    visit(ind);
+    for (const WtEdge &edge : this->map_->boxes(ind).edges()) {
+      if (agent.dist[edge.first] != UINT32_MAX)
+        visit(edge.first);
+    }
+  }
+  return false;
+}
+
+// Check if a plan still fits the current reservations
+bool Fleet::fits(const Agent &agent, const std::vector<size_t> &plan) const {
+  for (size_t t = 1; t < plan.size(); t++) {
+    if (!this->table_.is_free(plan[t], t))
+      return false;
+  }
+  return plan.back() != agent.trg ||
+         this->table_.is_free_from(agent.trg, plan.size() - 1);
+}
+
+// Get the boxes hit by the body of a drone centered in a box
+void Fleet::hit(size_t ind, std::vector<size_t> &boxes) const {
+  const long nx = this->map_->nx(), ny = this->map_->ny(),
+             nz = this->map_->nz();
+  long x = ind / (ny * nz), y = (ind / nz) % ny, z = ind % nz;
+  boxes.clear();
+  for (const std::array<long, 3> &off : this->offsets_) {
+    long ox = x + off[0], oy = y + off[1], oz = z + off[2];
+    if (ox < 0 || ox >= nx || oy < 0 || oy >= ny || oz < 0 || oz >= nz)
+      continue;
+    boxes.push_back(oz + nz * (oy + ny * ox));
+  }
+}
+
+// Reserve the boxes hit by a drone at a time, or from a time on
+void Fleet::reserve(size_t ind, size_t t, bool park) {
+  std::vector<size_t> boxes;
+  this->hit(ind, boxes);
+  for (size_t other : boxes) {
+    if (park)
+      this->table_.park(other, t);
+    else
+      this->table_.reserve(other, t);
+  }
+}
+
+// Reserve the plan of a drone, it stays on its target after the plan
+void Fleet::reserve(const Agent &agent) {
+  size_t last = agent.plan.size() - 1;
+  for (size_t t = 0; t < last; t++)
+    this->reserve(agent.plan[t], t, false);
+  this->reserve(agent.plan[last], last, agent.plan[last] == agent.trg);
+}
+
+// Plan all the drones for the next window
+size_t Fleet::plan() {
+  NAV_TRACE("Fleet::plan");
+  NAV_TRACE_ARG("agents", this->agents_.size());
+  this->table_.clear();
+  // Each drone holds the boxes around its current one for the whole window,
+  // so a drone left without a plan can always wait in place
+  std::vector<size_t> boxes;
+  this->stays_.assign(this->map_->n(), 0);
+  for (const Agent &agent : this->agents_) {
+    this->hit(agent.str, boxes);
+    for (size_t ind : boxes)
+      this->stays_[ind]++;
+  }
+  // Drones on their targets first, the others fly around them
+  std::vector<size_t> order;
+  for (size_t i = 0; i < this->agents_.size(); i++) {
+    if (this->agents_[i].arrived())
+      order.push_back(i);
+  }
+  for (size_t i = 0; i < this->agents_.size(); i++) {
+    if (!this->agents_[i].arrived())
+      order.push_back(i);
+  }
+  // Search all the drones at once against the held boxes only, the drones
+  // are split among the threads
+  std::vector<std::vector<size_t>> plans(this->agents_.size());
+  std::vector<char> found(this->agents_.size(), false);
+  size_t n_threads = std::min(this->n_threads_, order.size());
+  if (n_threads > 1) {
+    auto search = [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; i++) {
+        size_t id = order[i];
+        found[id] = this->search(this->agents_[id], plans[id]);
+      }
+    };
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < n_threads; t++) {
+      workers.emplace_back(search, t * order.size() / n_threads,
+                           (t + 1) * order.size() / n_threads);
+    }
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+  // Keep the plans that fit the reservations of the drones before them,
+  // search the others again
+  size_t n_planned = 0;
+  for (size_t i : order) {
+    Agent &agent = this->agents_[i];
+    if (n_threads > 1 && found[i] && this->fits(agent, plans[i]))
+      this->kept_++;
+    else
+      found[i] = this->search(agent, plans[i]);
+    if (found[i]) {
+      agent.plan.swap(plans[i]);
+      n_planned++;
+    } else {
+      // Wait in place for the whole window
+      agent.plan.assign(this->window_ + 1, agent.str);
+      this->failures_++;
+    }
+    this->reserve(agent);
+  }
+  this->planned_ = this->time_;
+  return n_planned;
+}
+
+// Move all the drones one step, the plans are redone every half window or
+// when one runs out before its target
+bool Fleet::step() {
+  if (this->done())
+    return false;
+  bool replan = (this->planned_ == (size_t)-1) ||
+                (this->time_ - this->planned_ >= this->window_ / 2);
+  for (const Agent &agent : this->agents_)
+    replan |= (agent.plan.size() == 1 && !agent.arrived());
+  if (replan)
+    this->plan();
+  for (Agent &agent : this->agents_) {
+    if (agent.plan.size() > 1) {
+      agent.plan.erase(agent.plan.begin());
+      if (agent.plan.front() != agent.str)
+        agent.moves++;
+      else
+        agent.waits++;
+      agent.str = agent.plan.front();
+    }
+  }
+  this->time_++;
+  return !this->done();
+}
+
+// Check if all the drones are on their targets
+bool Fleet::done() const {
+  for (const Agent &agent : this->agents_) {
+    if (!agent.arrived())
+      return false;
+  }
+  return true;
+}
+
+} // namespace nav
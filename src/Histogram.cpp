@@ -0,0 +1,121 @@
+/**
+ * @file Histogram.cpp
+ * @brief Source file for class LatencyHistogram
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Histogram.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Values below SUB_BUCKETS have a bucket each. Above, a value with the most
+// significant bit in position msb falls in the bucket of its SUB_BITS + 1
+// leading bits, in the group of the shift that leaves them.
+
+// Get the bucket of a value
+size_t LatencyHistogram::bucket(uint64_t ns) {
+  if (ns < SUB_BUCKETS)
+    return ns;
+  size_t shift = 63 - __builtin_clzll(ns) - SUB_BITS;
+  return (shift + 1) * SUB_BUCKETS + (ns >> shift) - SUB_BUCKETS;
+}
+
+// Get the highest value of a bucket
+uint64_t LatencyHistogram::bucket_max(size_t ind) {
+  if (ind < SUB_BUCKETS)
+    return ind;
+  size_t shift = ind / SUB_BUCKETS - 1;
+  uint64_t sub = ind % SUB_BUCKETS + SUB_BUCKETS;
+  return ((sub + 1) << shift) - 1;
+}
+
+// Record a latency
+void LatencyHistogram::record_ns(uint64_t ns) {
+  if (this->counts_.empty())
+    this->counts_.assign((65 - SUB_BITS) * SUB_BUCKETS, 0);
+  this->counts_[bucket(ns)]++;
+  this->count_++;
+  this->min_ns_ = std::min(this->min_ns_, ns);
+  this->max_ns_ = std::max(this->max_ns_, ns);
+  this->sum_ns_ += ns;
+}
+
+// Remove all the values, the buckets are kept
+void LatencyHistogram::reset() {
+  std::fill(this->counts_.begin(), this->counts_.end(), 0);
+  this->count_ = 0;
+  this->min_ns_ = UINT64_MAX;
+  this->max_ns_ = 0;
+  this->sum_ns_ = 0.0;
+}
+
+// Add the values of another histogram
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  if (other.count_ == 0)
+    return;
+  if (this->counts_.empty())
+    this->counts_.assign(other.counts_.size(), 0);
+  for (size_t i = 0; i < other.counts_.size(); i++)
+    this->counts_[i] += other.counts_[i];
+  this->count_ += other.count_;
+  this->min_ns_ = std::min(this->min_ns_, other.min_ns_);
+  this->max_ns_ = std::max(this->max_ns_, other.max_ns_);
+  this->sum_ns_ += other.sum_ns_;
+}
+
+// Get the value below which p percent of the values fall, as the highest
+// value of its bucket within the recorded range
+double LatencyHistogram::percentile_ms(double p) const {
+  if (this->count_ == 0)
+    return 0.0;
+  uint64_t rank = (uint64_t)std::ceil(p / 100.0 * this->count_);
+  rank = std::min(std::max(rank, (uint64_t)1), this->count_);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < this->counts_.size(); i++) {
+    seen += this->counts_[i];
+    if (seen >= rank) {
+      uint64_t ns = std::min(std::max(bucket_max(i), this->min_ns_),
+                             this->max_ns_);
+      return ns / 1e6;
+    }
+  }
+  return this->max_ms();
+}
+
+// Write count, mean, p50, p90, p99, p99.9 and max on one line
+std::string LatencyHistogram::summary() const {
+  std::ostringstream os;
+  os << this->count_ << " calls, mean " << this->mean_ms() << " ms, p50 "
+     << this->percentile_ms(50.0) << " ms, p90 " << this->percentile_ms(90.0)
+     << " ms, p99 " << this->percentile_ms(99.0) << " ms, p99.9 "
+     << this->percentile_ms(99.9) << " ms, max " << this->max_ms() << " ms";
+  return os.str();
+}
+
+// Write the same values as a JSON object
+std::string LatencyHistogram::to_json() const {
+  std::ostringstream os;
+  os << "{\"count\": " << this->count_ << ", \"mean_ms\": " << this->mean_ms()
+     << ", \"p50_ms\": " << this->percentile_ms(50.0)
+     << ", \"p90_ms\": " << this->percentile_ms(90.0)
+     << ", \"p99_ms\": " << this->percentile_ms(99.0)
+     << ", \"p999_ms\": " << this->percentile_ms(99.9)
+     << ", \"max_ms\": " << this->max_ms() << "}";
+  return os.str();
+}
+
+} // namespace nav
@@ -0,0 +1,416 @@
+/**
+ * @file MapFile.cpp
+ * @brief Source file for class MapFile
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "MapFile.h"
+#include "Trace.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Append a value to a section
+template <typename T> static void push(std::vector<char> &sec, T val) {
+  sec.insert(sec.end(), (const char *)&val, (const char *)&val + sizeof(T));
+}
+
+// Append a point to a section
+static void push_pnt(std::vector<char> &sec, const Point &pnt) {
+  push<float>(sec, pnt.x());
+  push<float>(sec, pnt.y());
+  push<float>(sec, pnt.z());
+}
+
+// Write the header followed by the aligned sections
+static void write_sections(const std::string &path, MapHeader &hdr,
+                           std::vector<char> (&secs)[MAP_SECTIONS]) {
+  // Compute aligned offsets
+  uint64_t ofs = (sizeof(MapHeader) + MAP_ALIGN - 1) / MAP_ALIGN * MAP_ALIGN;
+  for (size_t sec = 0; sec < MAP_SECTIONS; sec++) {
+    hdr.ofs[sec] = ofs;
+    hdr.len[sec] = secs[sec].size();
+    ofs += (hdr.len[sec] + MAP_ALIGN - 1) / MAP_ALIGN * MAP_ALIGN;
+  }
+  // Write file
+  std::ofstream ofs_file(path, std::ios::binary | std::ios::trunc);
+  if (!ofs_file)
+    throw "ERROR: Cannot open map file for writing!";
+  std::vector<char> pad(MAP_ALIGN, 0);
+  ofs_file.write((const char *)&hdr, sizeof(MapHeader));
+  ofs_file.write(pad.data(), hdr.ofs[0] - sizeof(MapHeader));
+  for (size_t sec = 0; sec < MAP_SECTIONS; sec++) {
+    ofs_file.write(secs[sec].data(), secs[sec].size());
+    ofs_file.write(pad.data(), (MAP_ALIGN - secs[sec].size() % MAP_ALIGN) %
+                                   MAP_ALIGN);
+  }
+  if (!ofs_file)
+    throw "ERROR: Cannot write map file!";
+}
+
+// Check that the number of boxes matches the grid sizes
+static void check_dims(const MapHeader &hdr) {
+  if ((hdr.ny != 0 && hdr.nx > UINT64_MAX / hdr.ny) ||
+      (hdr.nz != 0 && hdr.nx * hdr.ny > UINT64_MAX / hdr.nz) ||
+      hdr.nx * hdr.ny * hdr.nz != hdr.n)
+    throw "ERROR: Map file is corrupted!";
+}
+
+// Check that the sections read for every box hold n entries
+static void check_boxes(const MapFile &file, uint64_t n) {
+  if (file.count<uint8_t>(MAP_STATE) < n ||
+      file.count<float>(MAP_CNTS) / 3 < n)
+    throw "ERROR: Map file is corrupted!";
+}
+
+// Check that an offset section holds n + 1 non-decreasing offsets ending
+// within a data section of count entries
+static void check_ofs(const MapFile &file, MapSection sec, uint64_t n,
+                      size_t count) {
+  if (file.count<uint64_t>(sec) <= n)
+    throw "ERROR: Map file is corrupted!";
+  const uint64_t *ofs = file.section<uint64_t>(sec);
+  for (uint64_t ind = 0; ind < n; ind++) {
+    if (ofs[ind] > ofs[ind + 1])
+      throw "ERROR: Map file is corrupted!";
+  }
+  if (ofs[n] > count)
+    throw "ERROR: Map file is corrupted!";
+}
+
+// Check that the box indexes of a section are below n
+static void check_inds(const MapFile &file, MapSection sec, uint64_t n) {
+  const uint32_t *inds = file.section<uint32_t>(sec);
+  for (size_t i = 0; i < file.count<uint32_t>(sec); i++) {
+    if (inds[i] >= n)
+      throw "ERROR: Map file is corrupted!";
+  }
+}
+
+// Map a file in memory
+MapFile::MapFile(const std::string &path)
+    : path_(path), fd_(-1), size_(0), data_(NULL) {
+  // Open file
+  this->fd_ = open(path.c_str(), O_RDONLY);
+  if (this->fd_ < 0)
+    throw "ERROR: Cannot open map file!";
+  struct stat st;
+  if (fstat(this->fd_, &st) < 0 || (size_t)st.st_size < sizeof(MapHeader)) {
+    close(this->fd_);
+    throw "ERROR: Map file is truncated!";
+  }
+  this->size_ = st.st_size;
+  // Map file
+  void *data = mmap(NULL, this->size_, PROT_READ, MAP_PRIVATE, this->fd_, 0);
+  if (data == MAP_FAILED) {
+    close(this->fd_);
+    throw "ERROR: Cannot map map file!";
+  }
+  this->data_ = (const char *)data;
+  // Check header
+  const MapHeader &hdr = this->header();
+  const char *err = NULL;
+  if (hdr.magic != MAP_MAGIC)
+    err = "ERROR: Not a map file!";
+  else if (hdr.version != MAP_VERSION)
+    err = "ERROR: Unsupported map file version!";
+  for (size_t sec = 0; err == NULL && sec < MAP_SECTIONS; sec++) {
+    if (hdr.ofs[sec] % MAP_ALIGN != 0 || hdr.ofs[sec] > this->size_ ||
+        hdr.len[sec] > this->size_ - hdr.ofs[sec])
+      err = "ERROR: Map file is corrupted!";
+  }
+  if (err != NULL) {
+    munmap((void *)this->data_, this->size_);
+    close(this->fd_);
+    throw err;
+  }
+}
+
+// Unmap the file
+MapFile::~MapFile() {
+  munmap((void *)this->data_, this->size_);
+  close(this->fd_);
+}
+
+// Fill a planner with the content of the file
+void MapFile::load(Planner &planner, bool with_pnts) const {
+  NAV_TRACE("MapFile::load");
+  const MapHeader &hdr = this->header();
+  if (hdr.kind != MAP_PLANNER)
+    throw "ERROR: Map file does not contain a planner!";
+  if (with_pnts && !hdr.has_pnts)
+    throw "ERROR: Map file does not contain points!";
+  // Check sections before touching the planner
+  check_dims(hdr);
+  if (hdr.str >= hdr.n || hdr.trg >= hdr.n)
+    throw "ERROR: Map file is corrupted!";
+  check_boxes(*this, hdr.n);
+  check_ofs(*this, MAP_NEIGH_OFS, hdr.n, this->count<uint32_t>(MAP_NEIGHS));
+  check_inds(*this, MAP_NEIGHS, hdr.n);
+  check_ofs(*this, MAP_EDGE_OFS, hdr.n,
+            std::min(this->count<uint32_t>(MAP_EDGE_DST),
+                     this->count<float>(MAP_EDGE_WT)));
+  check_inds(*this, MAP_EDGE_DST, hdr.n);
+  if (with_pnts) {
+    check_ofs(*this, MAP_FIX_OFS, hdr.n, this->count<float>(MAP_FIX_PNTS) / 3);
+    check_ofs(*this, MAP_SLAM_OFS, hdr.n,
+              this->count<float>(MAP_SLAM_PNTS) / 3);
+  }
+  // Set dimensions
+  planner.xlen_ = hdr.xlen;
+  planner.ylen_ = hdr.ylen;
+  planner.zlen_ = hdr.zlen;
+  planner.nx_ = hdr.nx;
+  planner.ny_ = hdr.ny;
+  planner.nz_ = hdr.nz;
+  planner.n_ = hdr.n;
+  planner.xstep_ = hdr.xstep;
+  planner.ystep_ = hdr.ystep;
+  planner.zstep_ = hdr.zstep;
+  planner.radius_ = hdr.radius;
+  planner.height_ = hdr.height;
+  planner.str_ = hdr.str;
+  planner.trg_ = hdr.trg;
+  planner.path_.clear();
+  // The heuristic table and the search labels belong to the old map
+  planner.h_trg_ = -1;
+  planner.labels_.clear();
+  // Sections
+  const uint8_t *state = this->section<uint8_t>(MAP_STATE);
+  const uint64_t *neigh_ofs = this->section<uint64_t>(MAP_NEIGH_OFS);
+  const uint32_t *neighs = this->section<uint32_t>(MAP_NEIGHS);
+  const uint64_t *edge_ofs = this->section<uint64_t>(MAP_EDGE_OFS);
+  const uint32_t *edge_dst = this->section<uint32_t>(MAP_EDGE_DST);
+  const float *edge_wt = this->section<float>(MAP_EDGE_WT);
+  const uint64_t *fix_ofs = this->section<uint64_t>(MAP_FIX_OFS);
+  const float *fix_pnts = this->section<float>(MAP_FIX_PNTS);
+  const uint64_t *slam_ofs = this->section<uint64_t>(MAP_SLAM_OFS);
+  const float *slam_pnts = this->section<float>(MAP_SLAM_PNTS);
+  // Fill boxes
+  planner.boxes_.assign(hdr.n, Box());
+  planner.updatable_.assign(hdr.n, false);
+  std::vector<size_t> box_neighs;
+  for (size_t ind = 0; ind < hdr.n; ind++) {
+    Box &box = planner.boxes_[ind];
+    box.set_ind(ind);
+    Point cnt = this->cnt(ind);
+    box.set_cnt(cnt);
+    if (state[ind] & MAP_IN)
+      box.set_in();
+    if (!(state[ind] & MAP_FREE))
+      box.set_busy();
+    planner.updatable_[ind] = (state[ind] & MAP_UPDATABLE);
+    box_neighs.assign(neighs + neigh_ofs[ind], neighs + neigh_ofs[ind + 1]);
+    box.set_neighs(box_neighs);
+    for (uint64_t i = edge_ofs[ind]; i < edge_ofs[ind + 1]; i++)
+      box.add_edge(edge_dst[i], edge_wt[i]);
+    if (!with_pnts)
+      continue;
+    for (uint64_t i = fix_ofs[ind]; i < fix_ofs[ind + 1]; i++)
+      box.add_fix_pnt(
+          Point(fix_pnts[3 * i], fix_pnts[3 * i + 1], fix_pnts[3 * i + 2]));
+    for (uint64_t i = slam_ofs[ind]; i < slam_ofs[ind + 1]; i++)
+      box.add_slam_pnt(
+          Point(slam_pnts[3 * i], slam_pnts[3 * i + 1], slam_pnts[3 * i + 2]));
+  }
+  planner.links_ = planner.find_connectivity();
+}
+
+// Fill an explorer with the content of the file
+void MapFile::load(Explorer &explorer, bool with_pnts) const {
+  NAV_TRACE("MapFile::load");
+  const MapHeader &hdr = this->header();
+  if (hdr.kind != MAP_EXPLORER)
+    throw "ERROR: Map file does not contain an explorer!";
+  if (with_pnts && !hdr.has_pnts)
+    throw "ERROR: Map file does not contain points!";
+  // Check sections before touching the explorer
+  check_dims(hdr);
+  check_boxes(*this, hdr.n);
+  if (this->count<uint32_t>(MAP_F) < hdr.n)
+    throw "ERROR: Map file is corrupted!";
+  check_ofs(*this, MAP_EDGE_OFS, hdr.n,
+            std::min(this->count<uint32_t>(MAP_EDGE_DST),
+                     this->count<float>(MAP_EDGE_WT)));
+  check_inds(*this, MAP_EDGE_DST, hdr.n);
+  if (with_pnts)
+    check_ofs(*this, MAP_FIX_OFS, hdr.n, this->count<float>(MAP_FIX_PNTS) / 3);
+  // Set dimensions
+  explorer.xlen_ = hdr.xlen;
+  explorer.ylen_ = hdr.ylen;
+  explorer.nx_ = hdr.nx;
+  explorer.ny_ = hdr.ny;
+  explorer.n_ = hdr.n;
+  explorer.xstep_ = hdr.xstep;
+  explorer.ystep_ = hdr.ystep;
+  explorer.radius_ = hdr.radius;
+  // Sections
+  const uint8_t *state = this->section<uint8_t>(MAP_STATE);
+  const uint64_t *edge_ofs = this->section<uint64_t>(MAP_EDGE_OFS);
+  const uint32_t *edge_dst = this->section<uint32_t>(MAP_EDGE_DST);
+  const float *edge_wt = this->section<float>(MAP_EDGE_WT);
+  const uint32_t *f = this->section<uint32_t>(MAP_F);
+  const uint64_t *fix_ofs = this->section<uint64_t>(MAP_FIX_OFS);
+  const float *fix_pnts = this->section<float>(MAP_FIX_PNTS);
+  // Fill boxes
+  explorer.boxes_.assign(hdr.n, ExpBox());
+  explorer.frontier_pos_.clear();
+  explorer.sat_.clear();
+  for (size_t ind = 0; ind < hdr.n; ind++) {
+    ExpBox &box = explorer.boxes_[ind];
+    box.set_ind(ind);
+    Point cnt = this->cnt(ind);
+    box.set_cnt(cnt);
+    if (!(state[ind] & MAP_FREE))
+      box.set_busy();
+    if (state[ind] & MAP_EXPLORED)
+      box.set_explored();
+    box.set_f(f[ind] == UINT32_MAX ? (size_t)-1 : f[ind]);
+    for (uint64_t i = edge_ofs[ind]; i < edge_ofs[ind + 1]; i++)
+      box.add_edge(edge_dst[i], edge_wt[i]);
+    if (!with_pnts)
+      continue;
+    for (uint64_t i = fix_ofs[ind]; i < fix_ofs[ind + 1]; i++)
+      box.add_fix_pnt(
+          Point(fix_pnts[3 * i], fix_pnts[3 * i + 1], fix_pnts[3 * i + 2]));
+  }
+}
+
+// Write a planner
+void MapFile::write(const std::string &path, const Planner &planner,
+                    bool with_pnts) {
+  NAV_TRACE("MapFile::write");
+  if (planner.n_ > UINT32_MAX)
+    throw "ERROR: Map is too large for the map file format!";
+  // Header
+  MapHeader hdr;
+  memset(&hdr, 0, sizeof(MapHeader));
+  hdr.magic = MAP_MAGIC;
+  hdr.version = MAP_VERSION;
+  hdr.kind = MAP_PLANNER;
+  hdr.has_pnts = with_pnts;
+  hdr.xlen = planner.xlen_;
+  hdr.ylen = planner.ylen_;
+  hdr.zlen = planner.zlen_;
+  hdr.xstep = planner.xstep_;
+  hdr.ystep = planner.ystep_;
+  hdr.zstep = planner.zstep_;
+  hdr.radius = planner.radius_;
+  hdr.height = planner.height_;
+  hdr.nx = planner.nx_;
+  hdr.ny = planner.ny_;
+  hdr.nz = planner.nz_;
+  hdr.n = planner.n_;
+  hdr.str = planner.str_;
+  hdr.trg = planner.trg_;
+  // Sections
+  std::vector<char> secs[MAP_SECTIONS];
+  uint64_t n_neighs = 0, n_edges = 0, n_fix = 0, n_slam = 0;
+  push<uint64_t>(secs[MAP_NEIGH_OFS], 0);
+  push<uint64_t>(secs[MAP_EDGE_OFS], 0);
+  if (with_pnts) {
+    push<uint64_t>(secs[MAP_FIX_OFS], 0);
+    push<uint64_t>(secs[MAP_SLAM_OFS], 0);
+  }
+  for (size_t ind = 0; ind < planner.n_; ind++) {
+    const Box &box = planner.boxes_[ind];
+    uint8_t state = (box.is_in() ? MAP_IN : 0) |
+                    (box.is_free() ? MAP_FREE : 0) |
+                    (planner.updatable_[ind] ? MAP_UPDATABLE : 0);
+    push<uint8_t>(secs[MAP_STATE], state);
+    push_pnt(secs[MAP_CNTS], box.cnt());
+    for (size_t neigh : box.neighs())
+      push<uint32_t>(secs[MAP_NEIGHS], neigh);
+    n_neighs += box.neighs().size();
+    push<uint64_t>(secs[MAP_NEIGH_OFS], n_neighs);
+    for (const WtEdge &edge : box.edges()) {
+      push<uint32_t>(secs[MAP_EDGE_DST], edge.first);
+      push<float>(secs[MAP_EDGE_WT], edge.second);
+    }
+    n_edges += box.edges().size();
+    push<uint64_t>(secs[MAP_EDGE_OFS], n_edges);
+    if (!with_pnts)
+      continue;
+    for (const Point &pnt : box.fix_pnts())
+      push_pnt(secs[MAP_FIX_PNTS], pnt);
+    n_fix += box.fix_pnts().size();
+    push<uint64_t>(secs[MAP_FIX_OFS], n_fix);
+    for (const Point &pnt : box.slam_pnts())
+      push_pnt(secs[MAP_SLAM_PNTS], pnt);
+    n_slam += box.slam_pnts().size();
+    push<uint64_t>(secs[MAP_SLAM_OFS], n_slam);
+  }
+  write_sections(path, hdr, secs);
+}
+
+// Write an explorer
+void MapFile::write(const std::string &path, const Explorer &explorer,
+                    bool with_pnts) {
+  NAV_TRACE("MapFile::write");
+  if (explorer.n_ > UINT32_MAX)
+    throw "ERROR: Map is too large for the map file format!";
+  // Header
+  MapHeader hdr;
+  memset(&hdr, 0, sizeof(MapHeader));
+  hdr.magic = MAP_MAGIC;
+  hdr.version = MAP_VERSION;
+  hdr.kind = MAP_EXPLORER;
+  hdr.has_pnts = with_pnts;
+  hdr.xlen = explorer.xlen_;
+  hdr.ylen = explorer.ylen_;
+  hdr.xstep = explorer.xstep_;
+  hdr.ystep = explorer.ystep_;
+  hdr.radius = explorer.radius_;
+  hdr.nx = explorer.nx_;
+  hdr.ny = explorer.ny_;
+  hdr.nz = 1;
+  hdr.n = explorer.n_;
+  // Sections
+  std::vector<char> secs[MAP_SECTIONS];
+  uint64_t n_edges = 0, n_fix = 0;
+  push<uint64_t>(secs[MAP_NEIGH_OFS], 0);
+  push<uint64_t>(secs[MAP_EDGE_OFS], 0);
+  if (with_pnts)
+    push<uint64_t>(secs[MAP_FIX_OFS], 0);
+  for (size_t ind = 0; ind < explorer.n_; ind++) {
+    const ExpBox &box = explorer.boxes_[ind];
+    uint8_t state = MAP_IN | (box.is_free() ? MAP_FREE : 0) |
+                    (box.is_explored() ? MAP_EXPLORED : 0);
+    push<uint8_t>(secs[MAP_STATE], state);
+    push_pnt(secs[MAP_CNTS], box.cnt());
+    push<uint64_t>(secs[MAP_NEIGH_OFS], 0);
+    for (const WtEdge &edge : box.edges()) {
+      push<uint32_t>(secs[MAP_EDGE_DST], edge.first);
+      push<float>(secs[MAP_EDGE_WT], edge.second);
+    }
+    n_edges += box.edges().size();
+    push<uint64_t>(secs[MAP_EDGE_OFS], n_edges);
+    push<uint32_t>(secs[MAP_F], box.f() > UINT32_MAX ? UINT32_MAX : box.f());
+    if (!with_pnts)
+      continue;
+    for (const Point &pnt : box.fix_pnts())
+      push_pnt(secs[MAP_FIX_PNTS], pnt);
+    n_fix += box.fix_pnts().size();
+    push<uint64_t>(secs[MAP_FIX_OFS], n_fix);
+  }
+  write_sections(path, hdr, secs);
+}
+
+} // namespace nav
@@ -0,0 +1,86 @@
+/**
+ * @file MapStore.cpp
+ * @brief Source file for class MapStore
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <atomic>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "MapStore.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Initialize the store from the boxes of a planner
+MapStore::MapStore(const Planner &planner)
+    : planner_(&planner), back_(planner), n_busy_(0), epoch_(0) {
+  this->front_ = std::make_shared<const MapSnapshot>(0, this->back_);
+}
+
+// Set busy the boxes whose drone cylinder contains the point. Boxes are only
+// set busy, so checking the new points against the neighbors of their box is
+// the same as Planner::update checking all the points of the neighbors.
+size_t MapStore::ingest_pnt(const Point &pnt) {
+  size_t ind = this->planner_->pnt_to_ind(pnt);
+  if (ind >= this->planner_->n() || !this->planner_->is_updatable(ind))
+    return 0;
+  size_t ny = this->planner_->ny(), nz = this->planner_->nz();
+  size_t count = 0;
+  for (size_t ind_neigh : this->planner_->boxes(ind).neighs()) {
+    if (!this->planner_->is_updatable(ind_neigh))
+      continue;
+    const Point &cnt = this->planner_->boxes(ind_neigh).cnt();
+    if (cnt.dist_xy(pnt) > this->planner_->radius() ||
+        cnt.dist_z(pnt) > this->planner_->height())
+      continue;
+    size_t ix = ind_neigh / (ny * nz), iy = (ind_neigh / nz) % ny,
+           iz = ind_neigh % nz;
+    uint8_t state = this->back_.state(ix, iy, iz);
+    if (state & CELL_FREE) {
+      this->back_.set(ix, iy, iz, state & ~CELL_FREE);
+      count++;
+    }
+  }
+  return count;
+}
+
+// Ingest SLAM points in the back buffer
+size_t MapStore::ingest(const std::vector<Point> &pnts) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->ingest_range(pnts.begin(), pnts.end());
+}
+size_t MapStore::ingest(const std::list<Point> &pnts) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->ingest_range(pnts.begin(), pnts.end());
+}
+
+// Publish the back buffer as a new snapshot
+uint64_t MapStore::publish() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  std::shared_ptr<const MapSnapshot> snap =
+      std::make_shared<const MapSnapshot>(++this->epoch_, this->back_);
+  std::atomic_store(&this->front_, snap);
+  return this->epoch_;
+}
+
+// Get the last published snapshot
+std::shared_ptr<const MapSnapshot> MapStore::snapshot() const {
+  return std::atomic_load(&this->front_);
+}
+
+// Get the number of boxes set busy by ingestion
+size_t MapStore::n_busy() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->n_busy_;
+}
+
+} // namespace nav
@@ -0,0 +1,163 @@
+/**
+ * @file Pipeline.cpp
+ * @brief Source file for class Pipeline
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <chrono>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Pipeline.h"
+#include "Stats.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Initialize the loop at a start point
+Pipeline::Pipeline(const Planner &planner, const Explorer &explorer,
+                   const Point &str, float range, size_t lookahead, bool async)
+    : planner_(&planner), explorer_(explorer), worker_(planner, async),
+      range_(range), lookahead_(lookahead), goal_(-1), job_(0),
+      finished_(false) {
+  this->pos_ = this->planner_->pnt_to_ind(str);
+  if (this->pos_ >= this->planner_->n())
+    throw "ERROR: Start point is out of map!";
+  const Box &box = this->planner_->boxes(this->pos_);
+  size_t exp_ind = this->explorer_.pnt_to_ind(str);
+  if (!box.is_free() || !box.is_in() ||
+      exp_ind >= this->explorer_.boxes().size() ||
+      !this->explorer_.boxes(exp_ind).is_free())
+    throw "ERROR: Start box is not free!";
+}
+
+// Propose the next goal from a box of the explorer
+size_t Pipeline::propose_goal(size_t exp_ind) {
+  const std::vector<size_t> &frontier = this->explorer_.frontier();
+  if (frontier.empty())
+    return -1;
+  std::list<size_t> exp_path;
+  if (exp_ind < this->explorer_.boxes().size() &&
+      this->explorer_.next_goal(exp_ind, exp_path))
+    return exp_path.back();
+  // Off the explored boxes, the closest frontier box in xy
+  const Point &cnt = this->planner_->boxes(this->pos_).cnt();
+  size_t goal = -1;
+  float min_dist = INF;
+  for (size_t ind : frontier) {
+    float dist = cnt.dist_xy(this->explorer_.boxes(ind).cnt());
+    if (dist < min_dist) {
+      min_dist = dist;
+      goal = ind;
+    }
+  }
+  return goal;
+}
+
+// Sense, update the goal, collect the path and move one box
+void Pipeline::tick() {
+  if (this->finished_)
+    return;
+  NAV_TRACE("Pipeline::tick");
+  auto start = std::chrono::steady_clock::now();
+  this->res_.ticks++;
+  // Explore the view of the current box
+  const Point &cnt = this->planner_->boxes(this->pos_).cnt();
+  size_t exp_ind = this->explorer_.pnt_to_ind(cnt);
+  if (exp_ind < this->explorer_.boxes().size() &&
+      this->explorer_.boxes(exp_ind).is_free())
+    this->explorer_.set_explored(exp_ind, this->range_);
+  // A goal in view is reached, its search is no longer needed
+  if (this->goal_ != (size_t)-1 &&
+      this->explorer_.boxes(this->goal_).is_explored()) {
+    this->goal_ = -1;
+    if (this->job_ != 0) {
+      this->worker_.cancel();
+      this->job_ = 0;
+      this->res_.cancelled++;
+    }
+  }
+  // Propose the next goal and plan from a box ahead, the path is cut there so
+  // the drone keeps moving while the search runs
+  if (this->goal_ == (size_t)-1) {
+    this->goal_ = this->propose_goal(exp_ind);
+    if (this->goal_ == (size_t)-1) {
+      this->finished_ = true;
+      this->res_.success = true;
+      this->path_.clear();
+      this->res_.tick_ms.push_back(elapsed_ms(start));
+      return;
+    }
+    this->res_.goals++;
+    NAV_TRACE_ARG("goal", this->goal_);
+    size_t from = this->pos_;
+    auto it = this->path_.begin();
+    for (size_t k = 0; k < this->lookahead_ && it != this->path_.end();
+         k++, it++)
+      from = *it;
+    this->path_.erase(it, this->path_.end());
+    const Point &trg = this->explorer_.boxes(this->goal_).cnt();
+    this->job_ = this->worker_.request(this->planner_->boxes(from).cnt(),
+                                       Point(trg.x(), trg.y(), cnt.z()));
+  }
+  // Collect the path, unreachable goals leave the frontier as explored
+  PlanResult plan;
+  if (this->job_ != 0 && this->worker_.poll(plan) && plan.id == this->job_) {
+    this->job_ = 0;
+    if (plan.success) {
+      this->path_.splice(this->path_.end(), plan.path);
+    } else {
+      this->explorer_.set_explored(this->goal_);
+      this->goal_ = -1;
+      this->res_.unreachable++;
+    }
+  }
+  // A goal at the end of the path that is still not in view is dropped too
+  if (this->job_ == 0 && this->path_.empty() && this->goal_ != (size_t)-1) {
+    this->explorer_.set_explored(this->goal_);
+    this->goal_ = -1;
+    this->res_.unreachable++;
+  }
+  // Move one box, or hover while the path is missing
+  if (!this->path_.empty()) {
+    size_t next = this->path_.front();
+    this->path_.pop_front();
+    this->res_.length += this->planner_->boxes(this->pos_).cnt().dist(
+        this->planner_->boxes(next).cnt());
+    this->pos_ = next;
+    this->res_.moves++;
+  } else {
+    this->res_.stalls++;
+  }
+  this->res_.tick_ms.push_back(elapsed_ms(start));
+}
+
+// Run until the exploration is over or max_ticks ticks are done
+PipelineResult Pipeline::run(size_t max_ticks, double period_ms) {
+  auto start = std::chrono::steady_clock::now();
+  auto next = start;
+  auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double, std::milli>(period_ms));
+  while (!this->finished_ && this->res_.ticks < max_ticks) {
+    this->tick();
+    if (period_ms > 0.0) {
+      next += period;
+      std::this_thread::sleep_until(next);
+    } else if (this->path_.empty()) {
+      // Let the worker run while hovering
+      std::this_thread::yield();
+    }
+  }
+  this->res_.total_ms = elapsed_ms(start);
+  return this->res_;
+}
+
+} // namespace nav
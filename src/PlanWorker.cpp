@@ -0,0 +1,135 @@
+/**
+ * @file PlanWorker.cpp
+ * @brief Source file for class PlanWorker
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <chrono>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "PlanWorker.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Initialize a worker on a copy of the planner
+PlanWorker::PlanWorker(const Planner &planner, bool async)
+    : planner_(planner), async_(async), stop_(false), pending_(false),
+      last_id_(0), ready_(false), cancel_(false) {
+  this->planner_.set_cancel(&this->cancel_);
+  if (this->async_)
+    this->thread_ = std::thread(&PlanWorker::run, this);
+}
+
+// Stop the background thread
+PlanWorker::~PlanWorker() {
+  if (!this->async_)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->stop_ = true;
+    this->cancel_ = true;
+  }
+  this->cv_.notify_one();
+  this->thread_.join();
+}
+
+// Loop of the background thread
+void PlanWorker::run() {
+  NAV_STAT(trace::set_thread_name("PlanWorker"));
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  while (true) {
+    this->cv_.wait(lock, [this]() { return this->stop_ || this->pending_; });
+    if (this->stop_)
+      return;
+    // Take the request, a newer one raises the flag again
+    uint64_t id = this->last_id_;
+    Point str = this->str_, trg = this->trg_;
+    this->pending_ = false;
+    this->cancel_ = false;
+    lock.unlock();
+    PlanResult result = this->plan(id, str, trg);
+    lock.lock();
+    // Results of superseded requests are dropped
+    if (id == this->last_id_) {
+      this->result_ = std::move(result);
+      this->ready_ = true;
+    }
+  }
+}
+
+// Search a path between two points
+PlanResult PlanWorker::plan(uint64_t id, const Point &str, const Point &trg) {
+  NAV_TRACE("PlanWorker::plan");
+  NAV_TRACE_ARG("id", id);
+  PlanResult result;
+  result.id = id;
+  auto start = std::chrono::steady_clock::now();
+  try {
+    this->planner_.set_str(str);
+    this->planner_.set_trg(trg);
+    this->planner_.search();
+    result.path = this->planner_.path();
+    result.success = true;
+  } catch (const char *err_msg) {
+    result.error = err_msg;
+  } catch (const std::string &err_msg) {
+    result.error = err_msg;
+  }
+  result.search_ms = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  return result;
+}
+
+// Request a path between two points
+uint64_t PlanWorker::request(const Point &str, const Point &trg) {
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  uint64_t id = ++this->last_id_;
+  this->ready_ = false;
+  if (!this->async_) {
+    this->cancel_ = false;
+    lock.unlock();
+    PlanResult result = this->plan(id, str, trg);
+    lock.lock();
+    this->result_ = std::move(result);
+    this->ready_ = true;
+    return id;
+  }
+  this->str_ = str;
+  this->trg_ = trg;
+  this->pending_ = true;
+  this->cancel_ = true;
+  lock.unlock();
+  this->cv_.notify_one();
+  return id;
+}
+
+// Drop the waiting request and abort the running search
+void PlanWorker::cancel() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->last_id_++;
+  this->pending_ = false;
+  this->ready_ = false;
+  this->cancel_ = true;
+}
+
+// Get the result of the last request without blocking
+bool PlanWorker::poll(PlanResult &result) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (!this->ready_)
+    return false;
+  result = std::move(this->result_);
+  this->ready_ = false;
+  return true;
+}
+
+} // namespace nav
@@ -15,55 +15,35 @@
 /*---------------------------------------------------------------------------*/
 namespace nav {
 
-// Initialize a map
+// Initialize the sizes of a map, the boxes are built apart
 Planner::Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny,
-                 size_t nz, float radius, float height,
-                 std::list<Point> fix_pntcloud)
+                 size_t nz, float radius, float height)
     : xlen_(xlen), ylen_(ylen), zlen_(zlen), nx_(nx), ny_(ny), nz_(nz),
       n_(nx * ny * nz), radius_(radius), height_(height), boxes_(n_),
-      updatable_(n_, true) {
-  // Compute step
-  this->xstep_ = nav::round(xlen / (float)nx);
-  this->ystep_ = nav::round(ylen / (float)ny);
-  this->zstep_ = nav::round(zlen / (float)nz);
-  // Map size
-  std::vector<size_t> size = {this->nx_, this->ny_, this->nz_};
-  // Set the size of the surrounding
-  int xy_level = (int)ceil((this->radius_ - (this->xstep_ / 2)) / this->xstep_);
-  int z_level = (int)ceil((this->height_ - (this->zstep_ / 2)) / this->zstep_);
-  // Divide the space in boxes
-  std::vector<size_t> *idxs;
-  std::vector<size_t> *neighs;
-  for (size_t ind = 0; ind < this->n_; ind++) {
-    // Set the box index
-    this->boxes_[ind].set_ind(ind);
-    // Set the center of the box
-    idxs = nav::ind_to_sub(size, ind);
-    if (idxs == NULL)
-      throw "ind_to_sub() on " + std::to_string(ind) + " failed!";
-    float xcnt = nav::round((this->xstep_ * idxs->at(0)) + (this->xstep_ / 2));
-    float ycnt = nav::round((this->ystep_ * idxs->at(1)) + (this->ystep_ / 2));
-    float zcnt = nav::round((this->zstep_ * idxs->at(2)) + (this->zstep_ / 2));
-    Point cnt(xcnt, ycnt, zcnt);
-    this->boxes_[ind].set_cnt(cnt);
-    // Check if the box is inside the space
-    if (((0 <= (xcnt - this->radius_)) &&
-         ((xcnt + this->radius_) <= this->xlen_)) &&
-        ((0 <= (ycnt - this->radius_)) &&
-         ((ycnt + this->radius_) <= this->ylen_)) &&
-        ((0 <= (zcnt - this->height_)) &&
-         ((zcnt + this->height_) <= this->zlen_))) {
-      this->boxes_[ind].set_in();
-    } else {
-      this->boxes_[ind].set_out();
-      this->updatable_[ind] = false;
-    }
-    // Set box neighbors
-    neighs = nav::find_neighs(size, ind, xy_level, z_level);
-    if (neighs == NULL)
-      throw "find_neighs() on " + std::to_string(ind) + " failed!";
-    this->boxes_[ind].set_neighs(*neighs);
-  }
+      updatable_(n_, true), str_(0), trg_(0), links_(LINKS_10), repair_(3),
+      int_cost_(false), stamp_(0), h_table_(false), h_trg_(-1),
+      cancel_(NULL) {}
+
+// Initialize a map
+Planner::Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny,
+                 size_t nz, float radius, float height,
+                 std::list<Point> fix_pntcloud, Connectivity links)
+    : Planner(xlen, ylen, zlen, nx, ny, nz, radius, height) {
+  NAV_TRACE("Planner::Planner");
+  this->build(RuntimeGrid(nx, ny, nz, links), fix_pntcloud);
+}
+
+// Initialize a map from an occupancy grid
+Planner::Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny,
+                 size_t nz, float radius, float height,
+                 const std::vector<uint8_t> &occupancy, Connectivity links)
+    : Planner(xlen, ylen, zlen, nx, ny, nz, radius, height) {
+  NAV_TRACE("Planner::Planner");
+  this->build(RuntimeGrid(nx, ny, nz, links), occupancy);
+}
+
+// Set fixed obstacles from fixed points
+void Planner::set_fix_pnts(const std::list<Point> &fix_pntcloud) {
   // Assign fixed points to the respective boxes
   for (const Point &pnt : fix_pntcloud) {
     size_t ind = this->pnt_to_ind(pnt);
@@ -89,25 +69,48 @@ Planner::Planner(float xlen, float ylen, float zlen, size_t nx, size_t ny,
         break;
     }
   }
-  // Link boxes close to each other
-  std::vector<size_t> *links;
+}
+
+// Set fixed obstacles from the closest point of each busy neighbor cell
+void Planner::set_occupancy(const std::vector<uint8_t> &occupancy) {
   for (size_t ind = 0; ind < this->n_; ind++) {
-    if (!this->boxes_[ind].is_free() || !this->boxes_[ind].is_in())
-      continue;
-    // Find links
-    links = nav::find_links(size, ind);
-    if (links == NULL)
-      throw "find_links() on " + std::to_string(ind) + " failed!";
-    // Set links
-    for (size_t link : *links) {
-      if (this->boxes_[link].is_free() && this->boxes_[link].is_in()) {
-        this->boxes_[ind].add_edge(
-            link, this->boxes_[ind].cnt().dist(this->boxes_[link].cnt()));
+    const Point &cnt = this->boxes_[ind].cnt();
+    for (size_t ind_neigh : this->boxes_[ind].neighs()) {
+      if (occupancy[ind_neigh] & CELL_FREE)
+        continue;
+      const Point &cell = this->boxes_[ind_neigh].cnt();
+      float dx = std::max(fabsf(cell.x() - cnt.x()) - this->xstep_ / 2, 0.0f);
+      float dy = std::max(fabsf(cell.y() - cnt.y()) - this->ystep_ / 2, 0.0f);
+      float dz = std::max(fabsf(cell.z() - cnt.z()) - this->zstep_ / 2, 0.0f);
+      if (nav::round(sqrt((dx * dx) + (dy * dy))) <= this->radius_ &&
+          nav::round(dz) <= this->height_) {
+        this->boxes_[ind].set_busy();
+        this->updatable_[ind] = false;
+        break;
       }
     }
   }
 }
 
+// Find the connectivity of the edges of a loaded map
+Connectivity Planner::find_connectivity() const {
+  RuntimeGrid grid(this->nx_, this->ny_, this->nz_);
+  Connectivity links = LINKS_6;
+  long cx, cy, cz, lx, ly, lz;
+  for (size_t ind = 0; ind < this->n_; ind++) {
+    grid_sub(grid, ind, cx, cy, cz);
+    for (const WtEdge &edge : this->boxes_[ind].edges()) {
+      grid_sub(grid, edge.first, lx, ly, lz);
+      bool xy = (lx != cx) && (ly != cy), z = (lz != cz);
+      if (z && (lx != cx || ly != cy))
+        return LINKS_26;
+      if (xy)
+        links = LINKS_10;
+    }
+  }
+  return links;
+}
+
 // Set start box
 void Planner::set_str(const Point &str_pnt) {
   // Check start point
@@ -132,37 +135,82 @@ void Planner::set_trg(const Point &trg_pnt) {
     throw "ERROR: Target box is not free!";
   // Set target box
   this->trg_ = trg_ind;
-  // Initialize boxes
-  for (size_t ind = 0; ind < this->n_; ind++) {
-    if (this->updatable_[ind]) {
-      this->boxes_[ind].set_h(
-          this->boxes_[ind].cnt().dist(this->boxes_[this->trg_].cnt()));
-    } else {
-      this->boxes_[ind].set_h(INF);
-    }
+  // Fill the heuristic table once per target, otherwise it is lazy
+  if (this->h_table_ && this->h_trg_ != this->trg_) {
+    for (size_t ind = 0; ind < this->n_; ind++)
+      this->boxes_[ind].set_h(this->heuristic(ind));
+    this->h_trg_ = this->trg_;
   }
 }
 
+// Compute the heuristic of a box, busy boxes are pushed to the end
+float Planner::heuristic(size_t ind) const {
+  if (!this->updatable_[ind] || !this->boxes_[ind].is_free())
+    return INF;
+  return this->boxes_[ind].cnt().dist(this->boxes_[this->trg_].cnt());
+}
+
 // Compute shortest path
 void Planner::search() {
+  NAV_STAT(StatTimer timer(this->stats_.search_ms,
+                           &this->stats_.search_max_ms,
+                           &this->stats_.search_hist));
+  NAV_STAT(this->stats_.searches++);
+  if (this->int_cost_)
+    this->search_int_(NULL);
+  else
+    this->search_(NULL);
+}
+
+// Compute shortest path on the free cells of a column map
+void Planner::search(const ColumnMap &occ) {
+  if (occ.nx() != this->nx_ || occ.ny() != this->ny_ || occ.nz() != this->nz_)
+    throw "ERROR: Column map does not match the planner size!";
+  NAV_STAT(StatTimer timer(this->stats_.search_ms,
+                           &this->stats_.search_max_ms,
+                           &this->stats_.search_hist));
+  NAV_STAT(this->stats_.searches++);
+  if (this->int_cost_)
+    this->search_int_(&occ);
+  else
+    this->search_(&occ);
+}
+
+// Compute shortest path, optionally checking a column map
+void Planner::search_(const ColumnMap *occ) {
+  NAV_TRACE("Planner::search");
+  NAV_STAT(size_t expanded = this->stats_.expanded);
   // Initialize OPEN and close set
   FibonacciHeap<Node> OPEN;
   std::unordered_set<size_t> CLOSED;
   // Setup start box
   this->boxes_[this->str_].set_g(0.0f);
+  if (!this->h_table_)
+    this->boxes_[this->str_].set_h(this->heuristic(this->str_));
   OPEN.insert(Node(this->str_, this->boxes_[this->str_].get_f()));
+  NAV_STAT(this->stats_.pushes++);
   // Loop on OPEN set
   while (!OPEN.isEmpty()) {
+    if (this->cancel_ != NULL &&
+        this->cancel_->load(std::memory_order_relaxed)) {
+      NAV_STAT(this->stats_.failures++);
+      throw "ERROR: Search cancelled!";
+    }
     // Pop first vertex from the OPEN set and add it to the CLOSED set
     Node curr = OPEN.removeMinimum();
     CLOSED.insert(curr.ind());
+    NAV_STAT(this->stats_.expanded++);
     // Check if the target has been reached
     if (curr.ind() == this->trg_) {
+      NAV_TRACE_ARG("expanded", this->stats_.expanded - expanded);
       this->set_path();
       return;
     }
     // Loop on edges
     for (WtEdge edge : this->boxes_[curr.ind()].edges()) {
+      // Skip links that are busy in the column map
+      if (occ != NULL && !(occ->state(edge.first) & CELL_FREE))
+        continue;
       // Cost to reach the link passing through the current vertex
       float g_score = nav::round(this->boxes_[curr.ind()].g() + edge.second);
       // Check if the vertex is in the OPEN set
@@ -173,9 +221,13 @@ void Planner::search() {
       bool in_CLOSED = (CLOSED.find(edge.first) != CLOSED.end());
       //
       if (!in_OPEN && !in_CLOSED) {
+        // First touch in this search
+        if (!this->h_table_)
+          this->boxes_[edge.first].set_h(this->heuristic(edge.first));
         this->boxes_[edge.first].set_g(g_score);
         this->boxes_[edge.first].set_pred(curr.ind());
         OPEN.insert(Node(edge.first, this->boxes_[edge.first].get_f()));
+        NAV_STAT(this->stats_.pushes++);
       } else {
         if (g_score < this->boxes_[edge.first].g()) {
           this->boxes_[edge.first].set_g(g_score);
@@ -183,15 +235,120 @@ void Planner::search() {
           if (in_OPEN) {
             OPEN.decreaseKey(
                 temp, Node(edge.first, this->boxes_[edge.first].get_f()));
+            NAV_STAT(this->stats_.decrease_keys++);
           }
           if (in_CLOSED) {
             CLOSED.erase(edge.first);
             OPEN.insert(Node(edge.first, this->boxes_[edge.first].get_f()));
+            NAV_STAT(this->stats_.pushes++);
           }
         }
       }
     }
   }
+  NAV_STAT(this->stats_.failures++);
+  NAV_TRACE_ARG("expanded", this->stats_.expanded - expanded);
+  throw "ERROR: No path found!";
+}
+
+// Compute shortest path with integer step costs on a radix queue
+void Planner::search_int_(const ColumnMap *occ) {
+  NAV_TRACE("Planner::search_int");
+  NAV_STAT(size_t expanded = this->stats_.expanded);
+  // Fixed-point step costs by the axes changed, x in bit 2, y in bit 1 and
+  // z in bit 0
+  uint32_t w[8];
+  for (size_t axes = 0; axes < 8; axes++) {
+    double dx = (axes & 4) ? this->xstep_ : 0.0;
+    double dy = (axes & 2) ? this->ystep_ : 0.0;
+    double dz = (axes & 1) ? this->zstep_ : 0.0;
+    w[axes] = (uint32_t)lround(sqrt(dx * dx + dy * dy + dz * dz) * COST_SCALE);
+  }
+  // Distance on the empty grid, exact hence consistent. With 26 links the
+  // diagonals through three axes go first, then the ones through z.
+  bool diag_z = (this->links_ == LINKS_26);
+  size_t nyz = this->ny_ * this->nz_;
+  long tx = this->trg_ / nyz, ty = (this->trg_ / this->nz_) % this->ny_,
+       tz = this->trg_ % this->nz_;
+  auto heuristic = [&](size_t ind) {
+    uint32_t dx = labs((long)(ind / nyz) - tx);
+    uint32_t dy = labs((long)((ind / this->nz_) % this->ny_) - ty);
+    uint32_t dz = labs((long)(ind % this->nz_) - tz);
+    uint32_t h = 0;
+    if (diag_z) {
+      uint32_t dxyz = std::min(std::min(dx, dy), dz);
+      dx -= dxyz;
+      dy -= dxyz;
+      dz -= dxyz;
+      uint32_t dxz = std::min(dx, dz), dyz = std::min(dy, dz);
+      dx -= dxz;
+      dy -= dyz;
+      dz -= dxz + dyz;
+      h += dxyz * w[7] + dxz * w[5] + dyz * w[3];
+    }
+    uint32_t dd = std::min(dx, dy);
+    return h + dd * w[6] + (dx - dd) * w[4] + (dy - dd) * w[2] + dz * w[1];
+  };
+  // Labels are reset lazily by bumping the stamp
+  if (this->labels_.size() != this->n_ || ++this->stamp_ == 0) {
+    this->labels_.assign(this->n_, CostLabel{0, 0, 0, false});
+    this->stamp_ = 1;
+  }
+  // Setup start box
+  RadixHeap<size_t> OPEN;
+  this->labels_[this->str_] = CostLabel{this->stamp_, 0, this->str_, false};
+  OPEN.push(heuristic(this->str_), this->str_);
+  NAV_STAT(this->stats_.pushes++);
+  // Loop on OPEN set
+  while (!OPEN.empty()) {
+    if (this->cancel_ != NULL &&
+        this->cancel_->load(std::memory_order_relaxed)) {
+      NAV_STAT(this->stats_.failures++);
+      throw "ERROR: Search cancelled!";
+    }
+    size_t curr = OPEN.pop().second;
+    CostLabel &label = this->labels_[curr];
+    if (label.closed) {
+      NAV_STAT(this->stats_.stale++);
+      continue;
+    }
+    label.closed = true;
+    NAV_STAT(this->stats_.expanded++);
+    // Check if the target has been reached
+    if (curr == this->trg_) {
+      NAV_TRACE_ARG("expanded", this->stats_.expanded - expanded);
+      this->path_.clear();
+      for (size_t ind = this->trg_; ind != this->str_;
+           ind = this->labels_[ind].pred)
+        this->path_.push_front(ind);
+      return;
+    }
+    // Loop on edges
+    size_t cx = curr / nyz, cy = (curr / this->nz_) % this->ny_,
+           cz = curr % this->nz_;
+    for (const WtEdge &edge : this->boxes_[curr].edges()) {
+      const Box &link = this->boxes_[edge.first];
+      if (!link.is_free() || !link.is_in())
+        continue;
+      // Skip links that are busy in the column map
+      if (occ != NULL && !(occ->state(edge.first) & CELL_FREE))
+        continue;
+      // Step cost from the direction of the link
+      size_t lx = edge.first / nyz, ly = (edge.first / this->nz_) % this->ny_,
+             lz = edge.first % this->nz_;
+      uint32_t g_score =
+          label.g + w[(lx != cx) * 4 + (ly != cy) * 2 + (lz != cz)];
+      CostLabel &next = this->labels_[edge.first];
+      if (next.stamp == this->stamp_ && (next.closed || g_score >= next.g))
+        continue;
+      next = CostLabel{this->stamp_, g_score, curr, false};
+      // Lazy insertion, stale entries are discarded by the closed flag
+      OPEN.push(g_score + heuristic(edge.first), edge.first);
+      NAV_STAT(this->stats_.pushes++);
+    }
+  }
+  NAV_STAT(this->stats_.failures++);
+  NAV_TRACE_ARG("expanded", this->stats_.expanded - expanded);
   throw "ERROR: No path found!";
 }
 
@@ -211,6 +368,12 @@ void Planner::set_path() {
 
 // Update map from SLAM pointcloud
 void Planner::update(std::list<Point> slam_pntcloud) {
+  NAV_TRACE("Planner::update");
+  NAV_STAT(StatTimer timer(this->stats_.update_ms,
+                           &this->stats_.update_max_ms,
+                           &this->stats_.update_hist));
+  NAV_STAT(this->stats_.updates++);
+  NAV_STAT(this->stats_.slam_pnts += slam_pntcloud.size());
   // Assign SLAM points to the respective boxes
   std::vector<bool> toverify(this->n_, false);
   for (const Point &pnt : slam_pntcloud) {
@@ -233,8 +396,10 @@ void Planner::update(std::list<Point> slam_pntcloud) {
               this->boxes_[ind].cnt().dist_z(pnt) <= this->height_)
             count++;
           if (count > 0) {
-            if (this->boxes_[ind].is_free())
+            if (this->boxes_[ind].is_free()) {
               updated.push_back(ind);
+              NAV_STAT(this->stats_.new_busy++);
+            }
             this->boxes_[ind].set_busy();
             this->boxes_[ind].set_h(INF);
             break;
@@ -245,15 +410,132 @@ void Planner::update(std::list<Point> slam_pntcloud) {
       }
     }
   }
+  NAV_TRACE_ARG("new_busy", updated.size());
   // Check if there are obstacles along the path
   for (size_t ind : this->path_) {
     if (!this->boxes_[ind].is_free() || !this->boxes_[ind].is_in()) {
-      this->search();
+      // Try to splice local detours, fall back to a global search
+      NAV_STAT(this->stats_.blocked++);
+      NAV_TRACE_ARG("blocked", 1);
+      bool repaired;
+      {
+        NAV_STAT(StatTimer timer(this->stats_.repair_ms));
+        repaired = this->repair_ >= 0 && this->repair_path();
+      }
+      if (repaired) {
+        NAV_STAT(this->stats_.repairs++);
+      } else {
+        NAV_STAT(this->stats_.researches++);
+        this->search();
+      }
       return;
     }
   }
 }
 
+// Update map with all the SLAM batches waiting in a queue
+size_t Planner::update(ScanQueue &queue) {
+  std::list<Point> slam_pntcloud;
+  size_t n_slots = queue.drain(slam_pntcloud);
+  if (n_slots > 0)
+    this->update(std::move(slam_pntcloud));
+  return n_slots;
+}
+
+// Compute a detour between two boxes inside a bounded window
+bool Planner::search_local(size_t src, size_t dst, std::list<size_t> &detour) {
+  RuntimeGrid grid(this->nx_, this->ny_, this->nz_);
+  if (src >= this->n_ || dst >= this->n_)
+    return false;
+  // Window containing both boxes enlarged by the repair margin
+  long src_sub[3], dst_sub[3];
+  grid_sub(grid, src, src_sub[0], src_sub[1], src_sub[2]);
+  grid_sub(grid, dst, dst_sub[0], dst_sub[1], dst_sub[2]);
+  long lo[3], hi[3];
+  for (size_t i = 0; i < 3; i++) {
+    lo[i] = std::min(src_sub[i], dst_sub[i]) - this->repair_;
+    hi[i] = std::max(src_sub[i], dst_sub[i]) + this->repair_;
+  }
+  // Local g-values and predecessors, the global ones are left untouched
+  std::unordered_map<size_t, float> g;
+  std::unordered_map<size_t, size_t> pred;
+  const Point &dst_cnt = this->boxes_[dst].cnt();
+  // Initialize OPEN and close set
+  FibonacciHeap<Node> OPEN;
+  std::unordered_set<size_t> CLOSED;
+  g[src] = 0.0f;
+  OPEN.insert(Node(src, this->boxes_[src].cnt().dist(dst_cnt)));
+  // Loop on OPEN set
+  while (!OPEN.isEmpty()) {
+    Node curr = OPEN.removeMinimum();
+    if (!CLOSED.insert(curr.ind()).second)
+      continue;
+    NAV_STAT(this->stats_.local_expanded++);
+    // Check if the local target has been reached
+    if (curr.ind() == dst) {
+      detour.clear();
+      for (size_t ind = dst; ind != src; ind = pred[ind])
+        detour.push_front(ind);
+      return true;
+    }
+    // Loop on edges
+    for (WtEdge edge : this->boxes_[curr.ind()].edges()) {
+      const Box &link = this->boxes_[edge.first];
+      if (!link.is_free() || !link.is_in() || CLOSED.count(edge.first))
+        continue;
+      // Skip boxes outside the repair window
+      long sub[3];
+      grid_sub(grid, edge.first, sub[0], sub[1], sub[2]);
+      bool inside = true;
+      for (size_t i = 0; i < 3; i++)
+        inside &= (lo[i] <= sub[i] && sub[i] <= hi[i]);
+      if (!inside)
+        continue;
+      // Cost to reach the link passing through the current vertex
+      float g_score = nav::round(g[curr.ind()] + edge.second);
+      auto it = g.find(edge.first);
+      if (it != g.end() && g_score >= it->second)
+        continue;
+      g[edge.first] = g_score;
+      pred[edge.first] = curr.ind();
+      // Lazy insertion, stale entries are discarded by the CLOSED check
+      OPEN.insert(Node(edge.first, g_score + link.cnt().dist(dst_cnt)));
+    }
+  }
+  return false;
+}
+
+// Splice local detours around the blocked segments of the path
+bool Planner::repair_path() {
+  NAV_TRACE("Planner::repair_path");
+  std::list<size_t> repaired;
+  size_t last_free = this->str_;
+  auto it = this->path_.begin();
+  while (it != this->path_.end()) {
+    if (this->boxes_[*it].is_free() && this->boxes_[*it].is_in()) {
+      repaired.push_back(*it);
+      last_free = *it;
+      it++;
+      continue;
+    }
+    // Skip the blocked segment up to the first free box after it
+    while (it != this->path_.end() &&
+           (!this->boxes_[*it].is_free() || !this->boxes_[*it].is_in()))
+      it++;
+    if (it == this->path_.end())
+      return false;
+    // Search a bounded detour and splice it into the path
+    std::list<size_t> detour;
+    if (!this->search_local(last_free, *it, detour))
+      return false;
+    repaired.splice(repaired.end(), detour);
+    last_free = *it;
+    it++;
+  }
+  this->path_.swap(repaired);
+  return true;
+}
+
 //
 size_t Planner::move() {
   this->str_ = this->path_.front();
@@ -262,16 +544,11 @@ size_t Planner::move() {
 }
 
 // Compute the index of the corresponding box
-size_t Planner::pnt_to_ind(const Point &pnt) {
-  // Point idxs
-  std::vector<size_t> idxs(3);
-  idxs[0] = (int)floor(pnt.x() / xstep_);
-  idxs[1] = (int)floor(pnt.y() / ystep_);
-  idxs[2] = (int)floor(pnt.z() / zstep_);
-  // Map size
-  std::vector<size_t> size = {nx_, ny_, nz_};
-  // Convert idxs to ind
-  return nav::sub_to_ind(size, idxs);
+size_t Planner::pnt_to_ind(const Point &pnt) const {
+  return grid_ind(RuntimeGrid(this->nx_, this->ny_, this->nz_),
+                  (long)floor(pnt.x() / this->xstep_),
+                  (long)floor(pnt.y() / this->ystep_),
+                  (long)floor(pnt.z() / this->zstep_));
 }
 
 } // namespace nav
@@ -60,7 +60,7 @@ void Point::rotate_xy(const Point &cnt, float theta) {
 }
 
 // Check if the point is inside a box
-bool Point::is_inside_xy(std::vector<Point> &points) {
+bool Point::is_inside_xy(const std::vector<Point> &points) const {
   bool res = false;
   for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
     if (((points[i].y() >= this->y_) != (points[j].y() >= this->y_)) &&
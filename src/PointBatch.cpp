@@ -0,0 +1,339 @@
+/**
+ * @file PointBatch.cpp
+ * @brief Source file for the batch geometry kernels
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cmath>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define NAV_BATCH_AVX2
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "PointBatch.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+namespace batch {
+
+// The scalar kernels repeat the arithmetic of the Point methods (float sums,
+// double trigonometry, nav::round truncation) so that both paths agree
+// bit for bit. Point::dist_z goes through the integer abs, so the height
+// difference is truncated to whole units.
+
+#ifdef NAV_BATCH_AVX2
+static bool simd_ = __builtin_cpu_supports("avx2");
+#else
+static bool simd_ = false;
+#endif
+
+// Check if the AVX2 kernels are in use
+bool simd() { return simd_; }
+
+// Enable or disable the AVX2 kernels
+void set_simd(bool enable) {
+#ifdef NAV_BATCH_AVX2
+  simd_ = enable && __builtin_cpu_supports("avx2");
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/*                               Scalar kernels                              */
+/*---------------------------------------------------------------------------*/
+
+static void dist_scalar(const float *x, const float *y, const float *z,
+                        size_t first, size_t n, const Point &cnt, float *out) {
+  for (size_t i = first; i < n; i++) {
+    float dx = x[i] - cnt.x(), dy = y[i] - cnt.y(), dz = z[i] - cnt.z();
+    out[i] = nav::round(sqrt((dx * dx) + (dy * dy) + (dz * dz)));
+  }
+}
+
+static void dist_xy_scalar(const float *x, const float *y, size_t first,
+                           size_t n, const Point &cnt, float *out) {
+  for (size_t i = first; i < n; i++) {
+    float dx = x[i] - cnt.x(), dy = y[i] - cnt.y();
+    out[i] = nav::round(sqrt((dx * dx) + (dy * dy)));
+  }
+}
+
+static bool in_cylinder_scalar(float x, float y, float z, const Point &cnt,
+                               float radius, float height) {
+  float dx = x - cnt.x(), dy = y - cnt.y();
+  return nav::round(sqrt((dx * dx) + (dy * dy))) <= radius &&
+         truncf(fabsf(z - cnt.z())) <= height;
+}
+
+static bool in_polygon_scalar(float x, float y,
+                              const std::vector<Point> &polygon) {
+  return Point(x, y, 0.0f).is_inside_xy(polygon);
+}
+
+static void rotate_xy_scalar(float *x, float *y, size_t first, size_t n,
+                             const Point &cnt, double c, double s) {
+  for (size_t i = first; i < n; i++) {
+    float xtemp = x[i] - cnt.x(), ytemp = y[i] - cnt.y();
+    x[i] = nav::round(((c * xtemp) - (s * ytemp)) + cnt.x());
+    y[i] = nav::round(((s * xtemp) + (c * ytemp)) + cnt.y());
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                AVX2 kernels                               */
+/*---------------------------------------------------------------------------*/
+
+#ifdef NAV_BATCH_AVX2
+
+#define NAV_AVX2 __attribute__((target("avx2")))
+
+// nav::round on eight floats
+NAV_AVX2 static inline __m256 round8(__m256 val) {
+  const __m256 scale = _mm256_set1_ps(100000.0f);
+  return _mm256_div_ps(
+      _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_mul_ps(val, scale))),
+      scale);
+}
+
+// nav::round on four floats
+NAV_AVX2 static inline __m128 round4(__m128 val) {
+  const __m128 scale = _mm_set1_ps(100000.0f);
+  return _mm_div_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(val, scale))),
+                    scale);
+}
+
+// Store eight lane flags as bytes and return their number
+NAV_AVX2 static inline size_t store_mask8(__m256 mask, uint8_t *out) {
+  __m256i ones = _mm256_srli_epi32(_mm256_castps_si256(mask), 31);
+  __m128i half = _mm_packus_epi32(_mm256_castsi256_si128(ones),
+                                  _mm256_extracti128_si256(ones, 1));
+  _mm_storel_epi64((__m128i *)out, _mm_packus_epi16(half, half));
+  return __builtin_popcount(_mm256_movemask_ps(mask));
+}
+
+NAV_AVX2 static size_t dist_avx2(const float *x, const float *y,
+                                 const float *z, size_t n, const Point &cnt,
+                                 float *out) {
+  const __m256 cx = _mm256_set1_ps(cnt.x()), cy = _mm256_set1_ps(cnt.y()),
+               cz = _mm256_set1_ps(cnt.z());
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), cx);
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), cy);
+    __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), cz);
+    __m256 sq = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+        _mm256_mul_ps(dz, dz));
+    _mm256_storeu_ps(out + i, round8(_mm256_sqrt_ps(sq)));
+  }
+  return i;
+}
+
+NAV_AVX2 static size_t dist_xy_avx2(const float *x, const float *y, size_t n,
+                                    const Point &cnt, float *out) {
+  const __m256 cx = _mm256_set1_ps(cnt.x()), cy = _mm256_set1_ps(cnt.y());
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), cx);
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), cy);
+    __m256 sq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    _mm256_storeu_ps(out + i, round8(_mm256_sqrt_ps(sq)));
+  }
+  return i;
+}
+
+// Cylinder mask of eight points
+NAV_AVX2 static inline __m256 cylinder8(const float *x, const float *y,
+                                        const float *z, __m256 cx, __m256 cy,
+                                        __m256 cz, __m256 radius,
+                                        __m256 height) {
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x), cx);
+  __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y), cy);
+  __m256 dz = _mm256_and_ps(_mm256_sub_ps(_mm256_loadu_ps(z), cz), abs_mask);
+  __m256 dxy = round8(_mm256_sqrt_ps(
+      _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))));
+  dz = _mm256_round_ps(dz, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  return _mm256_and_ps(_mm256_cmp_ps(dxy, radius, _CMP_LE_OQ),
+                       _mm256_cmp_ps(dz, height, _CMP_LE_OQ));
+}
+
+NAV_AVX2 static size_t in_cylinder_avx2(const float *x, const float *y,
+                                        const float *z, size_t n,
+                                        const Point &cnt, float radius,
+                                        float height, uint8_t *out,
+                                        size_t &count) {
+  const __m256 cx = _mm256_set1_ps(cnt.x()), cy = _mm256_set1_ps(cnt.y()),
+               cz = _mm256_set1_ps(cnt.z()), r = _mm256_set1_ps(radius),
+               h = _mm256_set1_ps(height);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 mask = cylinder8(x + i, y + i, z + i, cx, cy, cz, r, h);
+    count += store_mask8(mask, out + i);
+  }
+  return i;
+}
+
+NAV_AVX2 static size_t any_in_cylinder_avx2(const float *x, const float *y,
+                                            const float *z, size_t n,
+                                            const Point &cnt, float radius,
+                                            float height, bool &found) {
+  const __m256 cx = _mm256_set1_ps(cnt.x()), cy = _mm256_set1_ps(cnt.y()),
+               cz = _mm256_set1_ps(cnt.z()), r = _mm256_set1_ps(radius),
+               h = _mm256_set1_ps(height);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 mask = cylinder8(x + i, y + i, z + i, cx, cy, cz, r, h);
+    if (_mm256_movemask_ps(mask)) {
+      found = true;
+      return n;
+    }
+  }
+  return i;
+}
+
+NAV_AVX2 static size_t in_polygon_avx2(const float *x, const float *y,
+                                       size_t n,
+                                       const std::vector<Point> &polygon,
+                                       uint8_t *out, size_t &count) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+    __m256 res = _mm256_setzero_ps();
+    // Crossing test of Point::is_inside_xy, one edge at a time
+    for (size_t e = 0, f = polygon.size() - 1; e < polygon.size(); f = e++) {
+      __m256 xe = _mm256_set1_ps(polygon[e].x());
+      __m256 ye = _mm256_set1_ps(polygon[e].y());
+      __m256 yf = _mm256_set1_ps(polygon[f].y());
+      __m256 dx = _mm256_set1_ps(polygon[f].x() - polygon[e].x());
+      __m256 dy = _mm256_set1_ps(polygon[f].y() - polygon[e].y());
+      __m256 cross = _mm256_xor_ps(_mm256_cmp_ps(ye, py, _CMP_GE_OQ),
+                                   _mm256_cmp_ps(yf, py, _CMP_GE_OQ));
+      __m256 xint = _mm256_add_ps(
+          _mm256_div_ps(_mm256_mul_ps(dx, _mm256_sub_ps(py, ye)), dy), xe);
+      res = _mm256_xor_ps(
+          res, _mm256_and_ps(cross, _mm256_cmp_ps(px, xint, _CMP_LE_OQ)));
+    }
+    count += store_mask8(res, out + i);
+  }
+  return i;
+}
+
+NAV_AVX2 static size_t rotate_xy_avx2(float *x, float *y, size_t n,
+                                      const Point &cnt, double c, double s) {
+  const __m128 cx = _mm_set1_ps(cnt.x()), cy = _mm_set1_ps(cnt.y());
+  const __m256d cxd = _mm256_set1_pd(cnt.x()), cyd = _mm256_set1_pd(cnt.y());
+  const __m256d cd = _mm256_set1_pd(c), sd = _mm256_set1_pd(s);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d xt = _mm256_cvtps_pd(_mm_sub_ps(_mm_loadu_ps(x + i), cx));
+    __m256d yt = _mm256_cvtps_pd(_mm_sub_ps(_mm_loadu_ps(y + i), cy));
+    __m256d xr = _mm256_add_pd(
+        _mm256_sub_pd(_mm256_mul_pd(cd, xt), _mm256_mul_pd(sd, yt)), cxd);
+    __m256d yr = _mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(sd, xt), _mm256_mul_pd(cd, yt)), cyd);
+    _mm_storeu_ps(x + i, round4(_mm256_cvtpd_ps(xr)));
+    _mm_storeu_ps(y + i, round4(_mm256_cvtpd_ps(yr)));
+  }
+  return i;
+}
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*                                  Dispatch                                 */
+/*---------------------------------------------------------------------------*/
+
+// Compute the distance of the points from a center
+void dist(const float *x, const float *y, const float *z, size_t n,
+          const Point &cnt, float *out) {
+  size_t i = 0;
+#ifdef NAV_BATCH_AVX2
+  if (simd_)
+    i = dist_avx2(x, y, z, n, cnt, out);
+#endif
+  dist_scalar(x, y, z, i, n, cnt, out);
+}
+
+// Compute the xy-distance of the points from a center
+void dist_xy(const float *x, const float *y, size_t n, const Point &cnt,
+             float *out) {
+  size_t i = 0;
+#ifdef NAV_BATCH_AVX2
+  if (simd_)
+    i = dist_xy_avx2(x, y, n, cnt, out);
+#endif
+  dist_xy_scalar(x, y, i, n, cnt, out);
+}
+
+// Flag the points inside a vertical cylinder
+size_t in_cylinder(const float *x, const float *y, const float *z, size_t n,
+                   const Point &cnt, float radius, float height,
+                   uint8_t *out) {
+  size_t i = 0, count = 0;
+#ifdef NAV_BATCH_AVX2
+  if (simd_)
+    i = in_cylinder_avx2(x, y, z, n, cnt, radius, height, out, count);
+#endif
+  for (; i < n; i++) {
+    out[i] = in_cylinder_scalar(x[i], y[i], z[i], cnt, radius, height);
+    count += out[i];
+  }
+  return count;
+}
+
+// Check if any point is inside a vertical cylinder
+bool any_in_cylinder(const float *x, const float *y, const float *z, size_t n,
+                     const Point &cnt, float radius, float height) {
+  size_t i = 0;
+  bool found = false;
+#ifdef NAV_BATCH_AVX2
+  if (simd_)
+    i = any_in_cylinder_avx2(x, y, z, n, cnt, radius, height, found);
+#endif
+  for (; i < n && !found; i++)
+    found = in_cylinder_scalar(x[i], y[i], z[i], cnt, radius, height);
+  return found;
+}
+
+// Flag the points inside a polygon in xy
+size_t in_polygon_xy(const float *x, const float *y, size_t n,
+                     const std::vector<Point> &polygon, uint8_t *out) {
+  size_t i = 0, count = 0;
+  if (polygon.empty()) {
+    std::fill(out, out + n, 0);
+    return 0;
+  }
+#ifdef NAV_BATCH_AVX2
+  if (simd_)
+    i = in_polygon_avx2(x, y, n, polygon, out, count);
+#endif
+  for (; i < n; i++) {
+    out[i] = in_polygon_scalar(x[i], y[i], polygon);
+    count += out[i];
+  }
+  return count;
+}
+
+// Rotate the points of theta on xy-axis
+void rotate_xy(float *x, float *y, size_t n, const Point &cnt, float theta) {
+  double c = cos((double)theta), s = sin((double)theta);
+  size_t i = 0;
+#ifdef NAV_BATCH_AVX2
+  if (simd_)
+    i = rotate_xy_avx2(x, y, n, cnt, c, s);
+#endif
+  rotate_xy_scalar(x, y, i, n, cnt, c, s);
+}
+
+} // namespace batch
+} // namespace nav
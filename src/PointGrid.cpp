@@ -0,0 +1,189 @@
+/**
+ * @file PointGrid.cpp
+ * @brief Source file for class PointGrid
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "PointGrid.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Points of a cell with z in [zmin, zmax]
+static std::pair<const Point *, const Point *>
+z_range(const Point *first, const Point *last, float zmin, float zmax) {
+  first = std::lower_bound(
+      first, last, zmin, [](const Point &pnt, float z) { return pnt.z() < z; });
+  last = std::upper_bound(
+      first, last, zmax, [](float z, const Point &pnt) { return z < pnt.z(); });
+  return {first, last};
+}
+
+// Bucket a pointcloud in cells of the given side
+PointGrid::PointGrid(const std::vector<Point> &pnts, float res)
+    : xmin_(0.0f), ymin_(0.0f), res_(res), nx_(0), ny_(0) {
+  if (res <= 0.0f)
+    throw "ERROR: Cell side must be positive!";
+  if (pnts.empty())
+    return;
+  // Grid bounds
+  float xmax = pnts[0].x(), ymax = pnts[0].y();
+  this->xmin_ = xmax;
+  this->ymin_ = ymax;
+  for (const Point &pnt : pnts) {
+    this->xmin_ = std::min(this->xmin_, pnt.x());
+    this->ymin_ = std::min(this->ymin_, pnt.y());
+    xmax = std::max(xmax, pnt.x());
+    ymax = std::max(ymax, pnt.y());
+  }
+  this->nx_ = (size_t)floor((xmax - this->xmin_) / res) + 1;
+  this->ny_ = (size_t)floor((ymax - this->ymin_) / res) + 1;
+  // Count the points of each cell
+  std::vector<size_t> cells(pnts.size());
+  this->ofs_.assign(this->nx_ * this->ny_ + 1, 0);
+  for (size_t i = 0; i < pnts.size(); i++) {
+    size_t ix = std::min(
+        (size_t)floor((pnts[i].x() - this->xmin_) / res), this->nx_ - 1);
+    size_t iy = std::min(
+        (size_t)floor((pnts[i].y() - this->ymin_) / res), this->ny_ - 1);
+    cells[i] = iy + this->ny_ * ix;
+    this->ofs_[cells[i] + 1]++;
+  }
+  for (size_t cell = 0; cell < this->nx_ * this->ny_; cell++)
+    this->ofs_[cell + 1] += this->ofs_[cell];
+  // Scatter the points in their cells and sort them along z
+  std::vector<size_t> next(this->ofs_.begin(), this->ofs_.end() - 1);
+  this->pnts_.resize(pnts.size());
+  for (size_t i = 0; i < pnts.size(); i++)
+    this->pnts_[next[cells[i]]++] = pnts[i];
+  for (size_t cell = 0; cell < this->nx_ * this->ny_; cell++) {
+    std::sort(this->pnts_.begin() + this->ofs_[cell],
+              this->pnts_.begin() + this->ofs_[cell + 1],
+              [](const Point &a, const Point &b) { return a.z() < b.z(); });
+  }
+  this->coords_ = PointArray(this->pnts_.begin(), this->pnts_.end());
+}
+
+// Collect the points of the cells in rows [ix0, ix1) inside the query
+void PointGrid::query_rows(const std::vector<Point> &polygon, float zmin,
+                           float zmax, size_t ix0, size_t ix1, size_t iy0,
+                           size_t iy1, std::vector<Point> &out) const {
+  std::vector<uint8_t> inside;
+  for (size_t ix = ix0; ix < ix1; ix++) {
+    float x0 = this->xmin_ + ix * this->res_, x1 = x0 + this->res_;
+    for (size_t iy = iy0; iy < iy1; iy++) {
+      size_t cell = iy + this->ny_ * ix;
+      if (this->ofs_[cell] == this->ofs_[cell + 1])
+        continue;
+      auto range = z_range(this->pnts_.data() + this->ofs_[cell],
+                           this->pnts_.data() + this->ofs_[cell + 1], zmin,
+                           zmax);
+      if (range.first == range.second)
+        continue;
+      // Cells with all the corners inside a convex polygon are taken whole
+      float y0 = this->ymin_ + iy * this->res_, y1 = y0 + this->res_;
+      if (Point(x0, y0, 0.0f).is_inside_xy(polygon) &&
+          Point(x1, y0, 0.0f).is_inside_xy(polygon) &&
+          Point(x1, y1, 0.0f).is_inside_xy(polygon) &&
+          Point(x0, y1, 0.0f).is_inside_xy(polygon)) {
+        out.insert(out.end(), range.first, range.second);
+        continue;
+      }
+      size_t first = range.first - this->pnts_.data();
+      size_t count = range.second - range.first;
+      inside.resize(count);
+      batch::in_polygon_xy(this->coords_.x.data() + first,
+                           this->coords_.y.data() + first, count, polygon,
+                           inside.data());
+      for (size_t i = 0; i < count; i++) {
+        if (inside[i])
+          out.push_back(range.first[i]);
+      }
+    }
+  }
+}
+
+// Get the points inside a convex polygon in xy and with z in [zmin, zmax]
+void PointGrid::query(const std::vector<Point> &polygon, float zmin,
+                      float zmax, std::vector<Point> &out,
+                      size_t n_threads) const {
+  if (polygon.size() < 3 || this->pnts_.empty())
+    return;
+  // Cells overlapping the bounding box of the polygon
+  float pxmin = polygon[0].x(), pxmax = pxmin;
+  float pymin = polygon[0].y(), pymax = pymin;
+  for (const Point &vtx : polygon) {
+    pxmin = std::min(pxmin, vtx.x());
+    pxmax = std::max(pxmax, vtx.x());
+    pymin = std::min(pymin, vtx.y());
+    pymax = std::max(pymax, vtx.y());
+  }
+  long ix0 = std::max(0L, (long)floor((pxmin - this->xmin_) / this->res_));
+  long ix1 = std::min((long)this->nx_,
+                      (long)floor((pxmax - this->xmin_) / this->res_) + 1);
+  long iy0 = std::max(0L, (long)floor((pymin - this->ymin_) / this->res_));
+  long iy1 = std::min((long)this->ny_,
+                      (long)floor((pymax - this->ymin_) / this->res_) + 1);
+  if (ix0 >= ix1 || iy0 >= iy1)
+    return;
+  // Split the rows among the threads, merged in order
+  n_threads = std::max((size_t)1, std::min(n_threads, (size_t)(ix1 - ix0)));
+  if (n_threads == 1) {
+    this->query_rows(polygon, zmin, zmax, ix0, ix1, iy0, iy1, out);
+    return;
+  }
+  std::vector<std::vector<Point>> parts(n_threads);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < n_threads; t++) {
+    size_t first = ix0 + t * (ix1 - ix0) / n_threads;
+    size_t last = ix0 + (t + 1) * (ix1 - ix0) / n_threads;
+    workers.emplace_back([&, first, last, t]() {
+      this->query_rows(polygon, zmin, zmax, first, last, iy0, iy1, parts[t]);
+    });
+  }
+  for (std::thread &worker : workers)
+    worker.join();
+  for (const std::vector<Point> &part : parts)
+    out.insert(out.end(), part.begin(), part.end());
+}
+
+// Get the points inside an axis-aligned box
+void PointGrid::query(const Point &min, const Point &max,
+                      std::vector<Point> &out) const {
+  if (this->pnts_.empty())
+    return;
+  long ix0 = std::max(0L, (long)floor((min.x() - this->xmin_) / this->res_));
+  long ix1 = std::min((long)this->nx_,
+                      (long)floor((max.x() - this->xmin_) / this->res_) + 1);
+  long iy0 = std::max(0L, (long)floor((min.y() - this->ymin_) / this->res_));
+  long iy1 = std::min((long)this->ny_,
+                      (long)floor((max.y() - this->ymin_) / this->res_) + 1);
+  for (long ix = ix0; ix < ix1; ix++) {
+    for (long iy = iy0; iy < iy1; iy++) {
+      size_t cell = iy + this->ny_ * ix;
+      auto range = z_range(this->pnts_.data() + this->ofs_[cell],
+                           this->pnts_.data() + this->ofs_[cell + 1], min.z(),
+                           max.z());
+      for (const Point *pnt = range.first; pnt != range.second; pnt++) {
+        if (min.x() <= pnt->x() && pnt->x() <= max.x() &&
+            min.y() <= pnt->y() && pnt->y() <= max.y())
+          out.push_back(*pnt);
+      }
+    }
+  }
+}
+
+} // namespace nav
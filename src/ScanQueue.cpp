@@ -0,0 +1,89 @@
+/**
+ * @file ScanQueue.cpp
+ * @brief Source file for class ScanQueue
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "ScanQueue.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// The indexes grow without wrapping, the slot of an index is index % n_slots.
+// The producer publishes the points of its slots with a release store on
+// tail_, the consumer gives the slots back with a release store on head_.
+
+// Allocate the slots
+ScanQueue::ScanQueue(size_t n_slots, size_t slot_size)
+    : n_slots_(n_slots), slot_size_(slot_size), head_(0), tail_(0),
+      rejected_(0) {
+  if (n_slots == 0 || slot_size == 0)
+    throw "ERROR: Empty scan queue!";
+  this->pnts_.resize(n_slots * slot_size);
+  this->sizes_.resize(n_slots, 0);
+}
+
+// Get the number of slots waiting for the consumer
+size_t ScanQueue::size() const {
+  size_t head = this->head_.load(std::memory_order_acquire);
+  size_t tail = this->tail_.load(std::memory_order_acquire);
+  return std::min(tail - head, this->n_slots_);
+}
+
+// Push a batch of points
+bool ScanQueue::push(const Point *pnts, size_t n) {
+  if (n == 0)
+    return true;
+  size_t needed = (n + this->slot_size_ - 1) / this->slot_size_;
+  size_t tail = this->tail_.load(std::memory_order_relaxed);
+  size_t head = this->head_.load(std::memory_order_acquire);
+  if (needed > this->n_slots_ - (tail - head)) {
+    this->rejected_.store(this->rejected_.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+    return false;
+  }
+  for (size_t k = 0; k < needed; k++) {
+    size_t slot = (tail + k) % this->n_slots_;
+    size_t count = std::min(this->slot_size_, n - k * this->slot_size_);
+    std::copy(pnts + k * this->slot_size_, pnts + k * this->slot_size_ + count,
+              this->pnts_.begin() + slot * this->slot_size_);
+    this->sizes_[slot] = count;
+  }
+  this->tail_.store(tail + needed, std::memory_order_release);
+  return true;
+}
+
+// Append the points of all the waiting slots
+size_t ScanQueue::drain(std::list<Point> &pnts) {
+  size_t head = this->head_.load(std::memory_order_relaxed);
+  size_t tail = this->tail_.load(std::memory_order_acquire);
+  for (size_t i = head; i < tail; i++) {
+    auto first = this->pnts_.begin() + (i % this->n_slots_) * this->slot_size_;
+    pnts.insert(pnts.end(), first, first + this->sizes_[i % this->n_slots_]);
+  }
+  this->head_.store(tail, std::memory_order_release);
+  return tail - head;
+}
+size_t ScanQueue::drain(std::vector<Point> &pnts) {
+  size_t head = this->head_.load(std::memory_order_relaxed);
+  size_t tail = this->tail_.load(std::memory_order_acquire);
+  for (size_t i = head; i < tail; i++) {
+    auto first = this->pnts_.begin() + (i % this->n_slots_) * this->slot_size_;
+    pnts.insert(pnts.end(), first, first + this->sizes_[i % this->n_slots_]);
+  }
+  this->head_.store(tail, std::memory_order_release);
+  return tail - head;
+}
+
+} // namespace nav
@@ -0,0 +1,144 @@
+/**
+ * @file Simulator.cpp
+ * @brief Source file for class Simulator
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Simulator.h"
+#include "Stats.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Initialize a simulator
+Simulator::Simulator(const Planner &planner, const PointGrid &world,
+                     const SensorParams &sensor)
+    : planner_(planner), world_(&world), sensor_(sensor), yaw_(0.0f) {}
+
+// Plan from start to target
+void Simulator::start(const Point &str, const Point &trg) {
+  NAV_TRACE("Simulator::start");
+  this->planner_.set_str(str);
+  this->planner_.set_trg(trg);
+  this->planner_.search();
+  this->yaw_ = 0.0f;
+  this->bounds_.clear();
+  this->step_ms_.clear();
+}
+
+// Sense the points in the footprint and update the planner
+std::list<Point> Simulator::sense() {
+  NAV_TRACE("Simulator::sense");
+  auto start = std::chrono::steady_clock::now();
+  // Heading towards the next box
+  Point curr_pnt = this->planner_.boxes(this->planner_.str()).cnt();
+  if (!this->planner_.path().empty()) {
+    Point next_pnt = this->planner_.boxes(this->planner_.path().front()).cnt();
+    if ((curr_pnt.x() != next_pnt.x()) || (curr_pnt.y() != next_pnt.y()))
+      this->yaw_ = curr_pnt.angle_xy(next_pnt);
+  }
+  // Sensor footprint
+  Point p1(curr_pnt.x() - this->sensor_.back, curr_pnt.y() - this->sensor_.side,
+           curr_pnt.z());
+  Point p2(curr_pnt.x() + this->sensor_.front,
+           curr_pnt.y() - this->sensor_.side, curr_pnt.z());
+  Point p3(curr_pnt.x() + this->sensor_.front,
+           curr_pnt.y() + this->sensor_.side, curr_pnt.z());
+  Point p4(curr_pnt.x() - this->sensor_.back, curr_pnt.y() + this->sensor_.side,
+           curr_pnt.z());
+  this->bounds_ = {p1, p2, p3, p4};
+  for (Point &pnt : this->bounds_)
+    pnt.rotate_xy(curr_pnt, this->yaw_);
+  // Points seen by the sensor
+  std::vector<Point> seen;
+  this->world_->query(this->bounds_, curr_pnt.z() - this->sensor_.height,
+                      curr_pnt.z() + this->sensor_.height, seen);
+  std::list<Point> pntcloud(seen.begin(), seen.end());
+  NAV_TRACE_ARG("pnts", seen.size());
+  // Update the map, it replans if the path is blocked
+  this->planner_.update(pntcloud);
+  this->step_ms_.push_back(elapsed_ms(start));
+  // The search crosses busy boxes when the target is no longer reachable
+  for (size_t ind : this->planner_.path()) {
+    const Box &box = this->planner_.boxes(ind);
+    if (!box.is_free() || !box.is_in())
+      throw "ERROR: Path is blocked!";
+  }
+  return pntcloud;
+}
+
+// Move to the next box of the path
+size_t Simulator::move() {
+  NAV_TRACE("Simulator::move");
+  if (this->planner_.path().empty())
+    throw "ERROR: Path is empty!";
+  return this->planner_.move();
+}
+
+// Run a mission until the target is reached or max_steps moves are done
+MissionResult Simulator::run(const Mission &mission, size_t max_steps) {
+  NAV_TRACE("Simulator::run");
+  MissionResult res;
+  auto start = std::chrono::steady_clock::now();
+  this->planner_.reset_stats();
+  try {
+    this->start(mission.str, mission.trg);
+    res.search_ms = elapsed_ms(start);
+    res.path.push_back(this->planner_.str());
+    while (!this->done() && res.steps < max_steps) {
+      this->sense();
+      res.path.push_back(this->move());
+      res.steps++;
+    }
+    res.success = this->done();
+    if (!res.success)
+      res.error = "ERROR: Step limit reached!";
+  } catch (const char *err_msg) {
+    res.error = err_msg;
+  } catch (const std::string &err_msg) {
+    res.error = err_msg;
+  }
+  res.step_ms = this->step_ms_;
+  res.total_ms = elapsed_ms(start);
+  res.stats = this->planner_.stats();
+  return res;
+}
+
+// Run missions in parallel, each one on its own copy of the planner
+std::vector<MissionResult> run_missions(const Planner &planner,
+                                        const PointGrid &world,
+                                        const std::vector<Mission> &missions,
+                                        size_t n_threads, size_t max_steps,
+                                        const SensorParams &sensor) {
+  std::vector<MissionResult> results(missions.size());
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> workers;
+  n_threads = std::max((size_t)1, n_threads);
+  for (size_t t = 0; t < n_threads; t++) {
+    workers.emplace_back([&, t]() {
+      NAV_STAT(trace::set_thread_name("Simulator " + std::to_string(t)));
+      for (size_t i = next++; i < missions.size(); i = next++) {
+        Simulator sim(planner, world, sensor);
+        results[i] = sim.run(missions[i], max_steps);
+      }
+    });
+  }
+  for (std::thread &worker : workers)
+    worker.join();
+  return results;
+}
+
+} // namespace nav
@@ -0,0 +1,116 @@
+/**
+ * @file Stats.cpp
+ * @brief Source file for the planner and explorer statistics
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <sstream>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Stats.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+// Write the fields of a JSON object, one per line
+class JsonFields {
+private:
+  std::ostringstream os_;
+  bool first_;
+
+public:
+  JsonFields() : first_(true) { os_ << "{"; }
+  template <typename T> JsonFields &add(const char *name, const T &value) {
+    os_ << (first_ ? "\n" : ",\n") << "  \"" << name << "\": " << value;
+    first_ = false;
+    return *this;
+  }
+  std::string str() {
+    os_ << "\n}";
+    return os_.str();
+  }
+};
+
+// Add the statistics of another planner
+void PlannerStats::add(const PlannerStats &other) {
+  this->build_ms += other.build_ms;
+  this->searches += other.searches;
+  this->failures += other.failures;
+  this->expanded += other.expanded;
+  this->pushes += other.pushes;
+  this->decrease_keys += other.decrease_keys;
+  this->stale += other.stale;
+  this->search_ms += other.search_ms;
+  this->search_max_ms = std::max(this->search_max_ms, other.search_max_ms);
+  this->updates += other.updates;
+  this->slam_pnts += other.slam_pnts;
+  this->new_busy += other.new_busy;
+  this->blocked += other.blocked;
+  this->repairs += other.repairs;
+  this->local_expanded += other.local_expanded;
+  this->researches += other.researches;
+  this->update_ms += other.update_ms;
+  this->update_max_ms = std::max(this->update_max_ms, other.update_max_ms);
+  this->repair_ms += other.repair_ms;
+  this->search_hist.merge(other.search_hist);
+  this->update_hist.merge(other.update_hist);
+}
+
+// Write the planner statistics as a JSON object
+std::string PlannerStats::to_json() const {
+  return JsonFields()
+      .add("build_ms", this->build_ms)
+      .add("searches", this->searches)
+      .add("failures", this->failures)
+      .add("expanded", this->expanded)
+      .add("pushes", this->pushes)
+      .add("decrease_keys", this->decrease_keys)
+      .add("stale", this->stale)
+      .add("search_ms", this->search_ms)
+      .add("search_max_ms", this->search_max_ms)
+      .add("updates", this->updates)
+      .add("slam_pnts", this->slam_pnts)
+      .add("new_busy", this->new_busy)
+      .add("blocked", this->blocked)
+      .add("repairs", this->repairs)
+      .add("local_expanded", this->local_expanded)
+      .add("researches", this->researches)
+      .add("update_ms", this->update_ms)
+      .add("update_max_ms", this->update_max_ms)
+      .add("repair_ms", this->repair_ms)
+      .add("search_latency", this->search_hist.to_json())
+      .add("update_latency", this->update_hist.to_json())
+      .str();
+}
+
+// Write the explorer statistics as a JSON object
+std::string ExplorerStats::to_json() const {
+  return JsonFields()
+      .add("build_ms", this->build_ms)
+      .add("explored", this->explored)
+      .add("field_inits", this->field_inits)
+      .add("field_repairs", this->field_repairs)
+      .add("field_raised", this->field_raised)
+      .add("field_pops", this->field_pops)
+      .add("field_ms", this->field_ms)
+      .add("sat_builds", this->sat_builds)
+      .add("sat_ms", this->sat_ms)
+      .add("goals", this->goals)
+      .add("goal_ms", this->goal_ms)
+      .add("views", this->views)
+      .add("view_expanded", this->view_expanded)
+      .add("view_cands", this->view_cands)
+      .add("view_ms", this->view_ms)
+      .str();
+}
+
+} // namespace nav
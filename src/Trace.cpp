@@ -0,0 +1,196 @@
+/**
+ * @file Trace.cpp
+ * @brief Source file for the timeline trace of the planning sessions
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Trace.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+namespace trace {
+
+// Each thread appends its events to a list of fixed chunks that it owns. A
+// chunk publishes its events with a release store on its count and the next
+// chunk is linked with a release store too, so the writer reads them without
+// stopping the thread. The buffers outlive their threads until clear().
+
+// Complete event
+struct Event {
+  const char *name;
+  const char *keys[2];
+  int64_t vals[2];
+  size_t n_args;
+  uint64_t ts_ns;
+  uint64_t dur_ns;
+};
+
+// Fixed block of events of one thread
+struct Chunk {
+  static const size_t SIZE = 4096;
+  Event events[SIZE];
+  std::atomic<size_t> count;
+  std::atomic<Chunk *> next;
+  Chunk() : count(0), next(NULL) {}
+};
+
+// Events of one thread
+struct Buffer {
+  size_t tid;       // Id of the thread in the trace
+  std::string name; // Name of the thread, guarded by mutex_
+  Chunk *head;      // First chunk
+  Chunk *tail;      // Chunk being filled, used by the owner only
+  Buffer(size_t tid) : tid(tid), head(new Chunk()), tail(head) {}
+  ~Buffer() {
+    for (Chunk *chunk = head; chunk != NULL;) {
+      Chunk *next = chunk->next.load(std::memory_order_relaxed);
+      delete chunk;
+      chunk = next;
+    }
+  }
+};
+
+std::atomic<bool> enabled_(false);
+
+static const std::chrono::steady_clock::time_point origin_ =
+    std::chrono::steady_clock::now();
+static std::mutex mutex_;                             // Guards the buffers
+static std::vector<std::unique_ptr<Buffer>> buffers_; // Buffers of the threads
+static std::atomic<size_t> generation_(0);            // Bumped by clear()
+static std::atomic<uint64_t> start_ns_(0), stop_ns_(0);
+static thread_local Buffer *local_ = NULL;
+static thread_local size_t local_generation_ = 0;
+
+// Get the buffer of the calling thread, registering it on first use
+static Buffer *local_buffer() {
+  size_t generation = generation_.load(std::memory_order_acquire);
+  if (local_ == NULL || local_generation_ != generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.emplace_back(new Buffer(buffers_.size() + 1));
+    local_ = buffers_.back().get();
+    local_generation_ = generation;
+  }
+  return local_;
+}
+
+// Start recording the events
+void start() {
+  start_ns_.store(now_ns(), std::memory_order_relaxed);
+  stop_ns_.store(UINT64_MAX, std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+}
+
+// Stop recording the events
+void stop() {
+  enabled_.store(false, std::memory_order_release);
+  stop_ns_.store(now_ns(), std::memory_order_relaxed);
+}
+
+// Write the events recorded between the last start and stop
+size_t write(const std::string &path) {
+  std::ofstream ofs(path);
+  if (!ofs)
+    throw "ERROR: Cannot open trace file!";
+  uint64_t start_ns = start_ns_.load(std::memory_order_relaxed);
+  uint64_t stop_ns = stop_ns_.load(std::memory_order_relaxed);
+  ofs.setf(std::ios::fixed);
+  ofs.precision(3);
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  size_t count = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const std::unique_ptr<Buffer> &buffer : buffers_) {
+    if (!buffer->name.empty()) {
+      ofs << (count++ ? ",\n" : "")
+          << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+          << buffer->tid << ",\"args\":{\"name\":\"" << buffer->name
+          << "\"}}";
+    }
+    for (Chunk *chunk = buffer->head; chunk != NULL;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      size_t n = chunk->count.load(std::memory_order_acquire);
+      for (size_t i = 0; i < n; i++) {
+        const Event &event = chunk->events[i];
+        if (event.ts_ns < start_ns || event.ts_ns >= stop_ns)
+          continue;
+        ofs << (count++ ? ",\n" : "") << "{\"ph\":\"X\",\"name\":\""
+            << event.name << "\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"ts\":" << event.ts_ns / 1e3
+            << ",\"dur\":" << event.dur_ns / 1e3;
+        if (event.n_args > 0) {
+          ofs << ",\"args\":{";
+          for (size_t k = 0; k < event.n_args; k++)
+            ofs << (k ? "," : "") << "\"" << event.keys[k]
+                << "\":" << event.vals[k];
+          ofs << "}";
+        }
+        ofs << "}";
+      }
+    }
+  }
+  ofs << "\n]}\n";
+  return count;
+}
+
+// Drop all the recorded events
+void clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.clear();
+  generation_.fetch_add(1, std::memory_order_release);
+}
+
+// Get the nanoseconds since the first use of the trace
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - origin_)
+      .count();
+}
+
+// Name the calling thread in the trace
+void set_thread_name(const std::string &name) {
+  Buffer *buffer = local_buffer();
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer->name = name;
+}
+
+// Record a complete event of the calling thread, a full chunk is followed by
+// a new one
+void record(const char *name, uint64_t ts_ns, uint64_t dur_ns,
+            const char *const *keys, const int64_t *vals, size_t n_args) {
+  Buffer *buffer = local_buffer();
+  Chunk *chunk = buffer->tail;
+  size_t n = chunk->count.load(std::memory_order_relaxed);
+  if (n == Chunk::SIZE) {
+    Chunk *next = new Chunk();
+    chunk->next.store(next, std::memory_order_release);
+    buffer->tail = chunk = next;
+    n = 0;
+  }
+  Event &event = chunk->events[n];
+  event.name = name;
+  event.n_args = n_args;
+  for (size_t k = 0; k < n_args; k++) {
+    event.keys[k] = keys[k];
+    event.vals[k] = vals[k];
+  }
+  event.ts_ns = ts_ns;
+  event.dur_ns = dur_ns;
+  chunk->count.store(n + 1, std::memory_order_release);
+}
+
+} // namespace trace
+} // namespace nav
@@ -0,0 +1,303 @@
+/**
+ * @file WorldGen.cpp
+ * @brief Source file for class WorldGen
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "ColumnMap.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                             Methods Definition                            */
+/*---------------------------------------------------------------------------*/
+namespace nav {
+
+#define WALL 0.2f // Wall thickness
+#define DOOR 1.0f // Door width
+
+// Generate a world
+WorldGen::WorldGen(const WorldParams &params)
+    : params_(params), rng_(params.seed) {
+  if (params.xlen <= 0.0f || params.ylen <= 0.0f || params.zlen <= 0.0f)
+    throw "ERROR: World dimensions must be positive!";
+  switch (params.kind) {
+  case WORLD_OFFICE:
+    this->gen_office(0.0f, params.zlen);
+    break;
+  case WORLD_WAREHOUSE:
+    this->gen_warehouse();
+    break;
+  case WORLD_FOREST:
+    this->gen_forest();
+    break;
+  case WORLD_MULTISTOREY:
+    this->gen_multistorey();
+    break;
+  }
+}
+
+// Add an obstacle clipped to the world
+void WorldGen::add(float x0, float y0, float z0, float x1, float y1,
+                   float z1) {
+  float lo[3] = {std::min(x0, x1), std::min(y0, y1), std::min(z0, z1)};
+  float hi[3] = {std::max(x0, x1), std::max(y0, y1), std::max(z0, z1)};
+  float len[3] = {this->params_.xlen, this->params_.ylen, this->params_.zlen};
+  for (size_t k = 0; k < 3; k++) {
+    lo[k] = std::max(lo[k], 0.0f);
+    hi[k] = std::min(hi[k], len[k]);
+    if (lo[k] >= hi[k])
+      return;
+  }
+  this->obstacles_.push_back(std::make_pair(Point(lo[0], lo[1], lo[2]),
+                                            Point(hi[0], hi[1], hi[2])));
+}
+
+// Draw a random value in [lo, hi)
+float WorldGen::uniform(float lo, float hi) {
+  return std::uniform_real_distribution<float>(lo, hi)(this->rng_);
+}
+
+// Rooms separated by walls with doors, furnished with desks
+void WorldGen::gen_office(float z0, float z1) {
+  float xlen = this->params_.xlen, ylen = this->params_.ylen;
+  // Outer walls
+  this->add(0.0f, 0.0f, z0, xlen, WALL, z1);
+  this->add(0.0f, ylen - WALL, z0, xlen, ylen, z1);
+  this->add(0.0f, 0.0f, z0, WALL, ylen, z1);
+  this->add(xlen - WALL, 0.0f, z0, xlen, ylen, z1);
+  // Room grid
+  std::vector<float> xs = {0.0f}, ys = {0.0f};
+  while (xs.back() + 8.0f <= xlen)
+    xs.push_back(xs.back() +
+                 this->uniform(4.0f, std::min(7.0f, xlen - 4.0f - xs.back())));
+  while (ys.back() + 8.0f <= ylen)
+    ys.push_back(ys.back() +
+                 this->uniform(4.0f, std::min(7.0f, ylen - 4.0f - ys.back())));
+  xs.push_back(xlen);
+  ys.push_back(ylen);
+  // Inner walls along y, one door per segment, the segments too short for a
+  // door are left open
+  for (size_t i = 1; i + 1 < xs.size(); i++) {
+    for (size_t j = 0; j + 1 < ys.size(); j++) {
+      if (ys[j + 1] - ys[j] < 2 * WALL + DOOR)
+        continue;
+      float door = this->uniform(ys[j] + WALL, ys[j + 1] - WALL - DOOR);
+      this->add(xs[i], ys[j], z0, xs[i] + WALL, door, z1);
+      this->add(xs[i], door + DOOR, z0, xs[i] + WALL, ys[j + 1], z1);
+    }
+  }
+  // Inner walls along x, one door per segment, the segments too short for a
+  // door are left open
+  for (size_t j = 1; j + 1 < ys.size(); j++) {
+    for (size_t i = 0; i + 1 < xs.size(); i++) {
+      if (xs[i + 1] - xs[i] < 2 * WALL + DOOR)
+        continue;
+      float door = this->uniform(xs[i] + WALL, xs[i + 1] - WALL - DOOR);
+      this->add(xs[i], ys[j], z0, door, ys[j] + WALL, z1);
+      this->add(door + DOOR, ys[j], z0, xs[i + 1], ys[j] + WALL, z1);
+    }
+  }
+  // Desks
+  for (size_t i = 0; i + 1 < xs.size(); i++) {
+    for (size_t j = 0; j + 1 < ys.size(); j++) {
+      if (xs[i + 1] - xs[i] < 4.0f || ys[j + 1] - ys[j] < 4.0f)
+        continue;
+      float area = (xs[i + 1] - xs[i]) * (ys[j + 1] - ys[j]);
+      int n_desks = (int)(this->params_.density * area / 8.0f);
+      for (int k = 0; k < n_desks; k++) {
+        float x = this->uniform(xs[i] + 1.0f, xs[i + 1] - 2.6f);
+        float y = this->uniform(ys[j] + 1.0f, ys[j + 1] - 1.8f);
+        this->add(x, y, z0, x + 1.6f, y + 0.8f,
+                  std::min(z0 + 0.75f, z1));
+      }
+    }
+  }
+}
+
+// Rows of racks with shelves, pallets in the aisles
+void WorldGen::gen_warehouse() {
+  float xlen = this->params_.xlen, ylen = this->params_.ylen;
+  float zlen = this->params_.zlen;
+  float rack_height = 0.85f * zlen;
+  // Outer walls
+  this->add(0.0f, 0.0f, 0.0f, xlen, WALL, zlen);
+  this->add(0.0f, ylen - WALL, 0.0f, xlen, ylen, zlen);
+  this->add(0.0f, 0.0f, 0.0f, WALL, ylen, zlen);
+  this->add(xlen - WALL, 0.0f, 0.0f, xlen, ylen, zlen);
+  // Rows of racks along x separated by aisles
+  for (float y = 3.0f; y + 1.0f < ylen - 3.0f; y += 4.0f) {
+    for (float x = 3.0f; x < xlen - 3.0f;) {
+      float len = std::min(this->uniform(8.0f, 15.0f), xlen - 3.0f - x);
+      if (len < 2.0f)
+        break;
+      // Posts
+      for (float px = x; px < x + len; px += 2.7f) {
+        this->add(px, y, 0.0f, px + 0.1f, y + 0.1f, rack_height);
+        this->add(px, y + 0.9f, 0.0f, px + 0.1f, y + 1.0f, rack_height);
+      }
+      this->add(x + len - 0.1f, y, 0.0f, x + len, y + 0.1f, rack_height);
+      this->add(x + len - 0.1f, y + 0.9f, 0.0f, x + len, y + 1.0f,
+                rack_height);
+      // Shelves
+      for (float z = 0.1f; z < rack_height; z += 1.2f)
+        this->add(x, y, z, x + len, y + 1.0f, z + 0.05f);
+      // Pallets in the aisle
+      for (float px = x; px + 1.2f < x + len; px += 1.5f) {
+        if (this->uniform(0.0f, 1.0f) < 0.2f * this->params_.density)
+          this->add(px, y + 1.5f, 0.0f, px + 1.2f, y + 2.3f,
+                    this->uniform(0.5f, 1.5f));
+      }
+      x += len + 2.0f;
+    }
+  }
+}
+
+// Trunks with canopies
+void WorldGen::gen_forest() {
+  float xlen = this->params_.xlen, ylen = this->params_.ylen;
+  float zlen = this->params_.zlen;
+  int n_trees = (int)(this->params_.density * xlen * ylen / 10.0f);
+  for (int i = 0; i < n_trees; i++) {
+    float x = this->uniform(0.0f, xlen), y = this->uniform(0.0f, ylen);
+    float side = this->uniform(0.3f, 0.6f);
+    float height = this->uniform(0.6f, 1.0f) * zlen;
+    this->add(x - side / 2, y - side / 2, 0.0f, x + side / 2, y + side / 2,
+              height);
+    float crown = this->uniform(2.0f, 4.0f);
+    this->add(x - crown / 2, y - crown / 2, 0.6f * height, x + crown / 2,
+              y + crown / 2, height);
+  }
+}
+
+// Office floors stacked on slabs with a shared stairwell
+void WorldGen::gen_multistorey() {
+  float xlen = this->params_.xlen, ylen = this->params_.ylen;
+  float storey = std::max(this->params_.storey, 1.0f);
+  size_t n_floors = std::max((size_t)1, (size_t)(this->params_.zlen / storey));
+  // Stairwell position
+  float sx = this->uniform(WALL, std::max(WALL, xlen - 3.0f - WALL));
+  float sy = this->uniform(WALL, std::max(WALL, ylen - 3.0f - WALL));
+  for (size_t f = 0; f < n_floors; f++) {
+    float z0 = f * storey;
+    float z1 = (f + 1 == n_floors) ? this->params_.zlen : z0 + storey;
+    // Slab with the stairwell hole
+    if (f > 0) {
+      this->add(0.0f, 0.0f, z0, sx, ylen, z0 + WALL);
+      this->add(sx + 3.0f, 0.0f, z0, xlen, ylen, z0 + WALL);
+      this->add(sx, 0.0f, z0, sx + 3.0f, sy, z0 + WALL);
+      this->add(sx, sy + 3.0f, z0, sx + 3.0f, ylen, z0 + WALL);
+      z0 += WALL;
+    }
+    this->gen_office(z0, z1);
+  }
+}
+
+// Sample the surfaces of the obstacles with the given resolution
+std::vector<Point> WorldGen::pntcloud(float res, size_t n_threads) const {
+  if (res <= 0.0f)
+    throw "ERROR: Resolution must be positive!";
+  n_threads = std::max((size_t)1, n_threads);
+  std::vector<std::vector<Point>> parts(n_threads);
+  std::vector<std::thread> workers;
+  size_t n = this->obstacles_.size();
+  for (size_t t = 0; t < n_threads; t++) {
+    workers.emplace_back([this, &parts, res, n, n_threads, t]() {
+      for (size_t i = t * n / n_threads; i < (t + 1) * n / n_threads; i++) {
+        const Point &lo = this->obstacles_[i].first;
+        const Point &hi = this->obstacles_[i].second;
+        // Samples along each axis, both faces are always included
+        std::vector<float> axes[3];
+        float l[3] = {lo.x(), lo.y(), lo.z()}, h[3] = {hi.x(), hi.y(), hi.z()};
+        for (size_t k = 0; k < 3; k++) {
+          for (float v = l[k]; v < h[k]; v += res)
+            axes[k].push_back(v);
+          axes[k].push_back(h[k]);
+        }
+        // Keep the samples lying on a face
+        for (size_t a = 0; a < axes[0].size(); a++) {
+          bool xface = (a == 0 || a + 1 == axes[0].size());
+          for (size_t b = 0; b < axes[1].size(); b++) {
+            bool yface = (b == 0 || b + 1 == axes[1].size());
+            for (size_t c = 0; c < axes[2].size(); c++) {
+              bool zface = (c == 0 || c + 1 == axes[2].size());
+              if (xface || yface || zface)
+                parts[t].emplace_back(axes[0][a], axes[1][b], axes[2][c]);
+              else
+                c = axes[2].size() - 2;
+            }
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers)
+    worker.join();
+  // Merge in obstacle order so that the output does not depend on threads
+  std::vector<Point> pntcloud;
+  for (std::vector<Point> &part : parts)
+    pntcloud.insert(pntcloud.end(), part.begin(), part.end());
+  return pntcloud;
+}
+
+// Rasterize the obstacles on a grid
+std::vector<uint8_t> WorldGen::occupancy(size_t nx, size_t ny, size_t nz,
+                                         size_t n_threads) const {
+  if (nx == 0 || ny == 0 || nz == 0)
+    throw "ERROR: Grid size must be positive!";
+  std::vector<uint8_t> grid(nx * ny * nz, CELL_IN | CELL_FREE);
+  float step[3] = {this->params_.xlen / nx, this->params_.ylen / ny,
+                   this->params_.zlen / nz};
+  size_t size[3] = {nx, ny, nz};
+  n_threads = std::max((size_t)1, std::min(n_threads, nx));
+  // Each thread owns a slab of x-indexes
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < n_threads; t++) {
+    workers.emplace_back([&, t]() {
+      size_t x_lo = t * nx / n_threads, x_hi = (t + 1) * nx / n_threads;
+      for (const Obstacle &obs : this->obstacles_) {
+        float l[3] = {obs.first.x(), obs.first.y(), obs.first.z()};
+        float h[3] = {obs.second.x(), obs.second.y(), obs.second.z()};
+        size_t lo[3], hi[3];
+        for (size_t k = 0; k < 3; k++) {
+          lo[k] = std::min((size_t)(l[k] / step[k]), size[k] - 1);
+          hi[k] = std::min((size_t)std::ceil(h[k] / step[k]), size[k]);
+          hi[k] = std::max(hi[k], lo[k] + 1);
+        }
+        lo[0] = std::max(lo[0], x_lo);
+        hi[0] = std::min(hi[0], x_hi);
+        for (size_t i = lo[0]; i < hi[0]; i++)
+          for (size_t j = lo[1]; j < hi[1]; j++)
+            for (size_t k = lo[2]; k < hi[2]; k++)
+              grid[k + nz * (j + ny * i)] = CELL_IN;
+      }
+    });
+  }
+  for (std::thread &worker : workers)
+    worker.join();
+  return grid;
+}
+
+// Convert the name of a world kind
+WorldKind world_kind(const std::string &name) {
+  if (name == "office")
+    return WORLD_OFFICE;
+  if (name == "warehouse")
+    return WORLD_WAREHOUSE;
+  if (name == "forest")
+    return WORLD_FOREST;
+  if (name == "multistorey")
+    return WORLD_MULTISTOREY;
+  throw "ERROR: Unknown world kind!";
+}
+
+} // namespace nav
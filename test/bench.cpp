@@ -0,0 +1,776 @@
+/**
+ * @file bench.cpp
+ * @brief Source file for the headless benchmark suite
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Explorer.h"
+#include "FixedPlanner.h"
+#include "MapFile.h"
+#include "MapStore.h"
+#include "Planner.h"
+#include "PointBatch.h"
+#include "PointGrid.h"
+#include "Stats.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+
+typedef std::map<std::string, double> Results;
+
+// Map configuration
+struct BenchMap {
+  float xlen, ylen, zlen;
+  size_t nx, ny, nz;
+};
+
+// Median of a set of samples
+double median(std::vector<double> samples) {
+  if (samples.empty())
+    return 0.0;
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+// Length of a path from the start box
+double path_length(const nav::Planner &planner, const std::list<size_t> &path) {
+  double length = 0.0;
+  size_t prev = planner.str();
+  for (size_t ind : path) {
+    const nav::Point &a = planner.boxes(prev).cnt(), &b = planner.boxes(ind).cnt();
+    length += sqrt((double)(a.x() - b.x()) * (a.x() - b.x()) +
+                   (double)(a.y() - b.y()) * (a.y() - b.y()) +
+                   (double)(a.z() - b.z()) * (a.z() - b.z()));
+    prev = ind;
+  }
+  return length;
+}
+
+// Pick a random free box inside the map
+size_t random_free(const nav::Planner &planner, std::mt19937 &rng) {
+  std::uniform_int_distribution<size_t> dist(0, planner.n() - 1);
+  for (size_t i = 0; i < 100000; i++) {
+    size_t ind = dist(rng);
+    if (planner.boxes(ind).is_free() && planner.boxes(ind).is_in())
+      return ind;
+  }
+  throw "ERROR: No free box found!";
+}
+
+// Step a greedy explorer as test/explorer.cpp did before the frontier, the
+// baseline of the frontier walk, return steps done. The backtrack retraces
+// the trail up to the last box with unexplored neighbors.
+size_t explore(nav::Explorer &explorer, size_t curr_ind, size_t max_steps,
+               double &length) {
+  std::list<size_t> exp_path;
+  exp_path.push_front(curr_ind);
+  explorer.set_explored(curr_ind);
+  size_t steps = 0;
+  length = 0.0;
+  for (; steps < max_steps; steps++) {
+    size_t min_score = -1;
+    float min_dist = INF;
+    size_t min_ind = -1;
+    for (nav::WtEdge edge : explorer.boxes(curr_ind).edges()) {
+      if (explorer.boxes(edge.first).is_explored())
+        continue;
+      size_t score = explorer.boxes(edge.first).f();
+      if (score < min_score || (score == min_score && edge.second < min_dist)) {
+        min_score = score;
+        min_dist = edge.second;
+        min_ind = edge.first;
+      }
+    }
+    if (min_score == (size_t)-1) {
+      // Backtrack to a box with unexplored neighbors
+      size_t next_ind = -1, prev_ind = curr_ind;
+      double back = 0.0;
+      for (size_t ind : exp_path) {
+        back += explorer.boxes(prev_ind).cnt().dist(explorer.boxes(ind).cnt());
+        prev_ind = ind;
+        if (explorer.boxes(ind).f()) {
+          next_ind = ind;
+          break;
+        }
+      }
+      if (next_ind == (size_t)-1 || next_ind == curr_ind)
+        break;
+      length += back;
+      curr_ind = next_ind;
+    } else {
+      length += min_dist;
+      curr_ind = min_ind;
+      exp_path.push_front(curr_ind);
+      explorer.set_explored(curr_ind);
+    }
+  }
+  return steps;
+}
+
+// Step the frontier explorer, return moves done
+size_t explore_frontier(nav::Explorer &explorer, size_t curr_ind,
+                        size_t max_steps, double &length) {
+  explorer.set_explored(curr_ind);
+  std::list<size_t> path;
+  size_t steps = 0;
+  length = 0.0;
+  while (steps < max_steps && explorer.next_goal(curr_ind, path)) {
+    for (size_t ind : path) {
+      length += explorer.boxes(curr_ind).cnt().dist(explorer.boxes(ind).cnt());
+      curr_ind = ind;
+      steps++;
+    }
+    explorer.set_explored(curr_ind);
+  }
+  return steps;
+}
+
+// Explore with a sensor view, moving to the closest frontier box or to the
+// best view when lambda is positive, return goals reached
+size_t explore_view(nav::Explorer &explorer, size_t curr_ind, float range,
+                    float lambda, double &length) {
+  explorer.set_explored(curr_ind, range);
+  std::list<size_t> path;
+  size_t goals = 0;
+  length = 0.0;
+  while (lambda > 0.0f ? explorer.next_view(curr_ind, range, lambda, path)
+                       : explorer.next_goal(curr_ind, path)) {
+    for (size_t ind : path) {
+      length += explorer.boxes(curr_ind).cnt().dist(explorer.boxes(ind).cnt());
+      curr_ind = ind;
+    }
+    explorer.set_explored(curr_ind, range);
+    goals++;
+  }
+  return goals;
+}
+
+// Count the unexplored free boxes within h boxes of a box by scanning them
+size_t scan_gain(const nav::Explorer &explorer, size_t ind, long h, size_t nx,
+                 size_t ny) {
+  long ix = ind / ny, iy = ind % ny;
+  size_t gain = 0;
+  long x1 = std::min((long)nx - 1, ix + h), y1 = std::min((long)ny - 1, iy + h);
+  for (long x = std::max(0L, ix - h); x <= x1; x++) {
+    for (long y = std::max(0L, iy - h); y <= y1; y++) {
+      const nav::ExpBox &box = explorer.boxes(y + ny * x);
+      gain += (box.is_free() && !box.is_explored()) ? 1 : 0;
+    }
+  }
+  return gain;
+}
+
+// Time the links of all the boxes of a grid, return nanoseconds per box
+template <class Grid> double links_ns(const Grid &grid, size_t &n_links) {
+  std::vector<size_t> links;
+  n_links = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t ind = 0; ind < grid.n(); ind++) {
+    links.clear();
+    nav::grid_links(grid, ind, links);
+    n_links += links.size();
+  }
+  return nav::elapsed_ms(start) * 1e6 / grid.n();
+}
+
+// Search a path, empty if there is none
+std::list<size_t> try_search(nav::Planner &planner, const nav::Point &str,
+                             const nav::Point &trg, bool int_cost) {
+  planner.set_int_cost(int_cost);
+  try {
+    planner.set_str(str);
+    planner.set_trg(trg);
+    planner.search();
+  } catch (const char *err_msg) {
+    planner.set_int_cost(false);
+    return std::list<size_t>();
+  }
+  planner.set_int_cost(false);
+  return planner.path();
+}
+
+// Count the queries whose paths differ between two planners on the same map,
+// with float or integer step costs, or whose integer cost path is longer
+size_t compare_paths(nav::Planner &a, nav::Planner &b, size_t reps) {
+  std::mt19937 rng(11);
+  size_t mismatch = 0;
+  for (size_t r = 0; r < reps; r++) {
+    nav::Point str = a.boxes(random_free(a, rng)).cnt();
+    nav::Point trg = a.boxes(random_free(a, rng)).cnt();
+    std::list<size_t> path = try_search(a, str, trg, false);
+    std::list<size_t> path_int = try_search(a, str, trg, true);
+    mismatch += path != try_search(b, str, trg, false) ||
+                path_int != try_search(b, str, trg, true) ||
+                path.empty() != path_int.empty();
+    if (!path.empty()) {
+      a.set_str(str);
+      mismatch += path_length(a, path_int) > path_length(a, path) + 1e-3;
+    }
+  }
+  return mismatch;
+}
+
+// Build the same map on a grid sized at compile time and compare the grid
+// walks on both grids, the boxes and the paths must match
+template <size_t NX, size_t NY, size_t NZ>
+void bench_fixed(const BenchMap &cfg, nav::Planner &planner,
+                 const std::list<nav::Point> &pntcloud, size_t reps,
+                 const std::string &key, Results &results) {
+  auto start = std::chrono::steady_clock::now();
+  nav::FixedPlanner<NX, NY, NZ> fixed(cfg.xlen, cfg.ylen, cfg.zlen,
+                                      planner.radius(), planner.height(),
+                                      pntcloud);
+  results[key + "construct_fixed_ms"] = nav::elapsed_ms(start);
+  size_t mismatch = 0;
+  for (size_t ind = 0; ind < planner.n(); ind++) {
+    const nav::Box &a = planner.boxes(ind), &b = fixed.boxes(ind);
+    mismatch += a.is_free() != b.is_free() || a.is_in() != b.is_in() ||
+                a.neighs() != b.neighs() || a.edges() != b.edges();
+  }
+  if (mismatch)
+    fprintf(stderr, "WARNING: %zu fixed grid boxes differ\n", mismatch);
+  mismatch = compare_paths(planner, fixed, reps);
+  // Same with the diagonals along z
+  nav::Planner planner26(cfg.xlen, cfg.ylen, cfg.zlen, cfg.nx, cfg.ny, cfg.nz,
+                         planner.radius(), planner.height(), pntcloud,
+                         nav::LINKS_26);
+  nav::FixedPlanner<NX, NY, NZ, nav::LINKS_26> fixed26(
+      cfg.xlen, cfg.ylen, cfg.zlen, planner.radius(), planner.height(),
+      pntcloud);
+  mismatch += compare_paths(planner26, fixed26, reps);
+  if (mismatch)
+    fprintf(stderr, "WARNING: %zu fixed grid paths differ\n", mismatch);
+  size_t n_runtime, n_fixed;
+  results[key + "links_runtime_ns"] =
+      links_ns(nav::RuntimeGrid(cfg.nx, cfg.ny, cfg.nz), n_runtime);
+  results[key + "links_fixed_ns"] =
+      links_ns(typename nav::FixedPlanner<NX, NY, NZ>::Grid(), n_fixed);
+  if (n_runtime != n_fixed)
+    fprintf(stderr, "WARNING: %zu fixed grid links, %zu expected\n", n_fixed,
+            n_runtime);
+}
+
+// Run all benchmarks on a map
+// Count the points where the batch kernels, with and without AVX2, differ
+// from the Point methods around a center
+size_t check_batch(const nav::PointArray &arr, const nav::Point &cnt,
+                   float radius, float height, float theta,
+                   const std::vector<nav::Point> &polygon) {
+  size_t n = arr.size(), mismatch = 0;
+  const float *x = arr.x.data(), *y = arr.y.data(), *z = arr.z.data();
+  std::vector<float> dist[2], dist_xy[2];
+  std::vector<uint8_t> cyl[2], poly[2];
+  nav::PointArray rot[2] = {arr, arr};
+  bool any[2];
+  for (int m = 0; m < 2; m++) {
+    nav::batch::set_simd(m == 1);
+    dist[m].resize(n);
+    dist_xy[m].resize(n);
+    cyl[m].resize(n);
+    poly[m].resize(n);
+    nav::batch::dist(x, y, z, n, cnt, dist[m].data());
+    nav::batch::dist_xy(x, y, n, cnt, dist_xy[m].data());
+    nav::batch::in_cylinder(x, y, z, n, cnt, radius, height, cyl[m].data());
+    any[m] = nav::batch::any_in_cylinder(x, y, z, n, cnt, radius, height);
+    nav::batch::in_polygon_xy(x, y, n, polygon, poly[m].data());
+    nav::batch::rotate_xy(rot[m].x.data(), rot[m].y.data(), n, cnt, theta);
+  }
+  bool any_pnt = false;
+  for (size_t i = 0; i < n; i++) {
+    nav::Point pnt = arr.at(i), rot_pnt = pnt;
+    rot_pnt.rotate_xy(cnt, theta);
+    // The height check goes through the truncated Point::dist_z
+    bool in_cyl = cnt.dist_xy(pnt) <= radius && cnt.dist_z(pnt) <= height;
+    any_pnt = any_pnt || in_cyl;
+    bool differ = false;
+    for (int m = 0; m < 2; m++)
+      differ = differ || dist[m][i] != cnt.dist(pnt) ||
+               dist_xy[m][i] != cnt.dist_xy(pnt) || cyl[m][i] != in_cyl ||
+               poly[m][i] != pnt.is_inside_xy(polygon) ||
+               rot[m].x[i] != rot_pnt.x() || rot[m].y[i] != rot_pnt.y();
+    mismatch += differ;
+  }
+  return mismatch + (any[0] != any_pnt) + (any[1] != any_pnt);
+}
+
+// Time a batch kernel over a set of centers, with or without AVX2, return
+// nanoseconds per point
+template <class Kernel>
+double batch_ns(bool simd, size_t n, size_t n_cnts, Kernel kernel) {
+  nav::batch::set_simd(simd);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < n_cnts; r++)
+    kernel(r);
+  return nav::elapsed_ms(start) * 1e6 / (n * n_cnts);
+}
+
+// Time the batch geometry kernels on the points of a world, with and without
+// AVX2, and compare them with the Point methods
+void bench_batch(const std::vector<nav::Point> &pnts, const std::string &key,
+                 Results &results) {
+  if (pnts.empty())
+    return;
+  bool simd = nav::batch::simd();
+  nav::PointArray arr(pnts.begin(), pnts.end()), rot = arr;
+  size_t n = arr.size();
+  const float *x = arr.x.data(), *y = arr.y.data(), *z = arr.z.data();
+  float radius = 1.0f, height = 0.5f, theta = 0.7f;
+  // Centers on the points, so that the cylinders are not empty
+  std::vector<nav::Point> cnts;
+  for (size_t r = 0; r < 10; r++)
+    cnts.push_back(pnts[(r * 7919) % n]);
+  // Field of view around the first center
+  std::vector<nav::Point> polygon = {
+      nav::Point(cnts[0].x() - 1.0f, cnts[0].y() - 1.0f, cnts[0].z()),
+      nav::Point(cnts[0].x() + 3.0f, cnts[0].y() - 1.0f, cnts[0].z()),
+      nav::Point(cnts[0].x() + 3.0f, cnts[0].y() + 1.0f, cnts[0].z()),
+      nav::Point(cnts[0].x() - 1.0f, cnts[0].y() + 1.0f, cnts[0].z())};
+  std::vector<float> dist(n);
+  std::vector<uint8_t> flags(n);
+  volatile bool sink = false;
+  const char *modes[2] = {"scalar", "simd"};
+  for (int m = 0; m < 2; m++) {
+    std::string prefix = key + "batch_";
+    std::string suffix = std::string("_") + modes[m] + "_ns";
+    results[prefix + "dist" + suffix] =
+        batch_ns(m == 1, n, cnts.size(), [&](size_t r) {
+          nav::batch::dist(x, y, z, n, cnts[r], dist.data());
+        });
+    results[prefix + "dist_xy" + suffix] =
+        batch_ns(m == 1, n, cnts.size(), [&](size_t r) {
+          nav::batch::dist_xy(x, y, n, cnts[r], dist.data());
+        });
+    results[prefix + "in_cylinder" + suffix] =
+        batch_ns(m == 1, n, cnts.size(), [&](size_t r) {
+          nav::batch::in_cylinder(x, y, z, n, cnts[r], radius, height,
+                                  flags.data());
+        });
+    // A center far above the points, so that the whole set is scanned
+    results[prefix + "any_in_cylinder" + suffix] =
+        batch_ns(m == 1, n, cnts.size(), [&](size_t r) {
+          nav::Point cnt(cnts[r].x(), cnts[r].y(), cnts[r].z() + 1000.0f);
+          sink = nav::batch::any_in_cylinder(x, y, z, n, cnt, radius, height);
+        });
+    results[prefix + "in_polygon_xy" + suffix] =
+        batch_ns(m == 1, n, cnts.size(), [&](size_t r) {
+          nav::batch::in_polygon_xy(x, y, n, polygon, flags.data());
+        });
+    results[prefix + "rotate_xy" + suffix] =
+        batch_ns(m == 1, n, cnts.size(), [&](size_t r) {
+          nav::batch::rotate_xy(rot.x.data(), rot.y.data(), n, cnts[r], theta);
+        });
+  }
+  (void)sink;
+  size_t mismatch = 0;
+  for (const nav::Point &cnt : cnts)
+    mismatch += check_batch(arr, cnt, radius, height, theta, polygon);
+  nav::batch::set_simd(simd);
+  if (mismatch > 0)
+    fprintf(stderr, "WARNING: %zu batch kernel results differ\n", mismatch);
+}
+
+void bench_map(const BenchMap &cfg, float density, size_t reps,
+               Results &results) {
+  char prefix[64];
+  snprintf(prefix, sizeof(prefix), "%zux%zux%zu/d%.2f/", cfg.nx, cfg.ny,
+           cfg.nz, density);
+  std::string key(prefix);
+  float radius = 0.5f, height = 0.25f;
+  std::mt19937 rng(42);
+
+  // World
+  nav::WorldParams params;
+  params.kind = nav::WORLD_FOREST;
+  params.xlen = cfg.xlen;
+  params.ylen = cfg.ylen;
+  params.zlen = cfg.zlen;
+  params.seed = 42;
+  params.density = density;
+  nav::WorldGen world(params);
+  std::vector<nav::Point> pnts = world.pntcloud(0.1f);
+  std::list<nav::Point> pntcloud(pnts.begin(), pnts.end());
+  results[key + "points"] = pnts.size();
+
+  // Construction
+  auto start = std::chrono::steady_clock::now();
+  nav::Planner planner(cfg.xlen, cfg.ylen, cfg.zlen, cfg.nx, cfg.ny, cfg.nz,
+                       radius, height, pntcloud);
+  results[key + "construct_ms"] = nav::elapsed_ms(start);
+
+  // Same map on a grid sized at compile time, for the sizes of main
+  if (cfg.nx == 60 && cfg.ny == 30 && cfg.nz == 9)
+    bench_fixed<60, 30, 9>(cfg, planner, pntcloud, reps, key, results);
+  else if (cfg.nx == 120 && cfg.ny == 60 && cfg.nz == 9)
+    bench_fixed<120, 60, 9>(cfg, planner, pntcloud, reps, key, results);
+  else if (cfg.nx == 240 && cfg.ny == 120 && cfg.nz == 18)
+    bench_fixed<240, 120, 18>(cfg, planner, pntcloud, reps, key, results);
+
+  // Point to index
+  std::uniform_real_distribution<float> ux(0.0f, cfg.xlen);
+  std::uniform_real_distribution<float> uy(0.0f, cfg.ylen);
+  std::uniform_real_distribution<float> uz(0.0f, cfg.zlen);
+  std::vector<nav::Point> queries;
+  for (size_t i = 0; i < 100000; i++)
+    queries.emplace_back(ux(rng), uy(rng), uz(rng));
+  volatile size_t sink = 0;
+  start = std::chrono::steady_clock::now();
+  for (const nav::Point &pnt : queries)
+    sink = planner.pnt_to_ind(pnt);
+  results[key + "pnt_to_ind_ns"] =
+      nav::elapsed_ms(start) * 1e6 / queries.size();
+  (void)sink;
+
+  // Batch geometry kernels
+  bench_batch(pnts, key, results);
+
+  // Search and update
+  std::vector<double> search, search_int, repair, global;
+  for (size_t r = 0; r < reps; r++) {
+    nav::Point str = planner.boxes(random_free(planner, rng)).cnt();
+    nav::Point trg = planner.boxes(random_free(planner, rng)).cnt();
+    try {
+      start = std::chrono::steady_clock::now();
+      planner.set_str(str);
+      planner.set_trg(trg);
+      planner.search();
+      search.push_back(nav::elapsed_ms(start));
+    } catch (const char *err_msg) {
+      continue;
+    }
+    // Same query with integer step costs on the radix queue
+    std::list<size_t> path = planner.path();
+    try {
+      planner.set_int_cost(true);
+      start = std::chrono::steady_clock::now();
+      planner.search();
+      search_int.push_back(nav::elapsed_ms(start));
+    } catch (const char *err_msg) {
+    }
+    planner.set_int_cost(false);
+    if (path_length(planner, planner.path()) >
+        path_length(planner, path) + 1e-3)
+      std::cerr << key << ": integer cost path is longer" << std::endl;
+    if (planner.path().size() < 3)
+      continue;
+    // Drop an obstacle on the middle of the path
+    auto it = planner.path().begin();
+    std::advance(it, planner.path().size() / 2);
+    nav::Point cnt = planner.boxes(*it).cnt();
+    std::list<nav::Point> slam;
+    for (float dx = -0.2f; dx <= 0.2f; dx += 0.1f)
+      for (float dy = -0.2f; dy <= 0.2f; dy += 0.1f)
+        for (float dz = -0.3f; dz <= 0.3f; dz += 0.1f)
+          slam.push_back(nav::Point(cnt.x() + dx, cnt.y() + dy, cnt.z() + dz));
+    for (int margin : {3, -1}) {
+      nav::Planner copy = planner;
+      copy.set_repair(margin);
+      try {
+        start = std::chrono::steady_clock::now();
+        copy.update(slam);
+        (margin < 0 ? global : repair).push_back(nav::elapsed_ms(start));
+      } catch (const char *err_msg) {
+      }
+    }
+  }
+  results[key + "search_ms"] = median(search);
+  results[key + "search_int_ms"] = median(search_int);
+  results[key + "update_repair_ms"] = median(repair);
+  results[key + "update_global_ms"] = median(global);
+
+  // Map snapshots, SLAM batches go to the back buffer and searches read the
+  // last published version
+  {
+    std::mt19937 snap_rng(7);
+    nav::MapStore store(planner);
+    std::vector<double> ingest, publish, search_snap;
+    for (size_t r = 0; r < reps; r++) {
+      nav::Point cnt = planner.boxes(random_free(planner, snap_rng)).cnt();
+      std::list<nav::Point> slam;
+      for (float dx = -0.2f; dx <= 0.2f; dx += 0.1f)
+        for (float dy = -0.2f; dy <= 0.2f; dy += 0.1f)
+          for (float dz = -0.3f; dz <= 0.3f; dz += 0.1f)
+            slam.push_back(
+                nav::Point(cnt.x() + dx, cnt.y() + dy, cnt.z() + dz));
+      start = std::chrono::steady_clock::now();
+      store.ingest(slam);
+      ingest.push_back(nav::elapsed_ms(start) * 1e3);
+      start = std::chrono::steady_clock::now();
+      store.publish();
+      publish.push_back(nav::elapsed_ms(start) * 1e3);
+    }
+    std::shared_ptr<const nav::MapSnapshot> snap = store.snapshot();
+    planner.set_int_cost(true);
+    for (size_t r = 0; r < reps; r++) {
+      try {
+        planner.set_str(planner.boxes(random_free(planner, snap_rng)).cnt());
+        planner.set_trg(planner.boxes(random_free(planner, snap_rng)).cnt());
+        start = std::chrono::steady_clock::now();
+        planner.search(snap->occ);
+        search_snap.push_back(nav::elapsed_ms(start));
+      } catch (const char *err_msg) {
+      }
+    }
+    planner.set_int_cost(false);
+    results[key + "snapshot_ingest_us"] = median(ingest);
+    results[key + "snapshot_publish_us"] = median(publish);
+    results[key + "snapshot_search_int_ms"] = median(search_snap);
+  }
+
+  // Sensor field of view, linear scan and grid query
+  std::vector<std::vector<nav::Point>> fovs;
+  for (size_t r = 0; r < 100; r++) {
+    nav::Point cnt(ux(rng), uy(rng), uz(rng));
+    float yaw = std::uniform_real_distribution<float>(-M_PI, M_PI)(rng);
+    std::vector<nav::Point> fov = {
+        nav::Point(cnt.x() - 1.0f, cnt.y() - 1.0f, cnt.z()),
+        nav::Point(cnt.x() + 3.0f, cnt.y() - 1.0f, cnt.z()),
+        nav::Point(cnt.x() + 3.0f, cnt.y() + 1.0f, cnt.z()),
+        nav::Point(cnt.x() - 1.0f, cnt.y() + 1.0f, cnt.z())};
+    for (nav::Point &vtx : fov)
+      vtx.rotate_xy(cnt, yaw);
+    fovs.push_back(fov);
+  }
+  size_t n_linear = 0, n_grid = 0;
+  start = std::chrono::steady_clock::now();
+  for (const std::vector<nav::Point> &fov : fovs) {
+    for (const nav::Point &pnt : pnts) {
+      if (pnt.is_inside_xy(fov) && fabsf(fov[0].z() - pnt.z()) <= 1.0f)
+        n_linear++;
+    }
+  }
+  results[key + "fov_linear_us"] = nav::elapsed_ms(start) * 1e3 / fovs.size();
+  start = std::chrono::steady_clock::now();
+  nav::PointGrid grid(pnts);
+  results[key + "fov_grid_build_ms"] = nav::elapsed_ms(start);
+  start = std::chrono::steady_clock::now();
+  for (const std::vector<nav::Point> &fov : fovs) {
+    std::vector<nav::Point> seen;
+    grid.query(fov, fov[0].z() - 1.0f, fov[0].z() + 1.0f, seen);
+    n_grid += seen.size();
+  }
+  results[key + "fov_grid_us"] = nav::elapsed_ms(start) * 1e3 / fovs.size();
+  if (n_linear != n_grid)
+    std::cerr << key << ": grid query returned " << n_grid << " points, "
+              << n_linear << " expected" << std::endl;
+
+  // Serialization load
+  std::string dat_path = "bench_planner.dat", map_path = "bench_planner.map";
+  {
+    std::ofstream ofs(dat_path);
+    boost::archive::binary_oarchive oa(ofs);
+    oa << planner;
+  }
+  nav::MapFile::write(map_path, planner);
+  {
+    start = std::chrono::steady_clock::now();
+    nav::Planner loaded;
+    std::ifstream ifs(dat_path);
+    boost::archive::binary_iarchive ia(ifs);
+    ia >> loaded;
+    results[key + "load_boost_ms"] = nav::elapsed_ms(start);
+  }
+  {
+    start = std::chrono::steady_clock::now();
+    nav::Planner loaded;
+    nav::MapFile(map_path).load(loaded);
+    results[key + "load_map_ms"] = nav::elapsed_ms(start);
+  }
+  std::remove(dat_path.c_str());
+  std::remove(map_path.c_str());
+
+  // Exploration
+  size_t ex = (size_t)cfg.xlen, ey = (size_t)cfg.ylen;
+  nav::Explorer explorer(cfg.xlen, cfg.ylen, ex, ey, radius, pntcloud);
+  size_t str_ind = -1;
+  for (size_t ind = 0; ind < ex * ey && str_ind == (size_t)-1; ind++) {
+    if (explorer.boxes(ind).is_free() && explorer.boxes(ind).f() > 0)
+      str_ind = ind;
+  }
+  if (str_ind != (size_t)-1) {
+    nav::Explorer greedy = explorer, fresh = explorer;
+    double length;
+    start = std::chrono::steady_clock::now();
+    size_t steps = explore(greedy, str_ind, 10 * ex * ey, length);
+    double ms = nav::elapsed_ms(start);
+    results[key + "explore_steps"] = steps;
+    results[key + "explore_step_us"] = steps ? ms * 1e3 / steps : 0.0;
+    results[key + "explore_ms"] = ms;
+    results[key + "explore_length_m"] = length;
+    start = std::chrono::steady_clock::now();
+    steps = explore_frontier(explorer, str_ind, 10 * ex * ey, length);
+    results[key + "frontier_ms"] = nav::elapsed_ms(start);
+    results[key + "frontier_steps"] = steps;
+    results[key + "frontier_length_m"] = length;
+    results[key + "explore_unexplored"] = greedy.frontier().size();
+    results[key + "frontier_unexplored"] = explorer.frontier().size();
+
+    // Information gain of the frontier boxes with a third of the map explored
+    float range = 3.0f;
+    nav::Explorer third = fresh;
+    for (size_t i = 0; i < ex * ey / 3; i++)
+      third.set_explored(rng() % (ex * ey));
+    std::vector<size_t> cands = third.frontier(), gains;
+    start = std::chrono::steady_clock::now();
+    third.info_gain(cands, range, gains);
+    results[key + "gain_sat_us"] = nav::elapsed_ms(start) * 1e3;
+    size_t mismatch = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cands.size(); i++)
+      mismatch += scan_gain(third, cands[i], (long)range, ex, ey) != gains[i];
+    results[key + "gain_scan_us"] = nav::elapsed_ms(start) * 1e3;
+    if (mismatch)
+      fprintf(stderr, "WARNING: %zu gains differ from the scan\n", mismatch);
+
+    // Exploration with a sensor view
+    nav::Explorer nearest = fresh;
+    start = std::chrono::steady_clock::now();
+    results[key + "view_nearest_goals"] =
+        explore_view(nearest, str_ind, range, 0.0f, length);
+    results[key + "view_nearest_ms"] = nav::elapsed_ms(start);
+    results[key + "view_nearest_length_m"] = length;
+    nav::Explorer nbv = fresh;
+    start = std::chrono::steady_clock::now();
+    results[key + "view_nbv_goals"] =
+        explore_view(nbv, str_ind, range, 0.2f, length);
+    results[key + "view_nbv_ms"] = nav::elapsed_ms(start);
+    results[key + "view_nbv_length_m"] = length;
+  }
+}
+
+// Write results as JSON
+void write_json(std::ostream &os, const Results &results) {
+  os << "{\n  \"benchmarks\": {\n";
+  size_t i = 0;
+  for (const auto &res : results) {
+    os << "    \"" << res.first << "\": " << res.second
+       << (++i < results.size() ? "," : "") << "\n";
+  }
+  os << "  }\n}\n";
+}
+
+// Read results written by write_json
+Results read_json(const std::string &path) {
+  std::ifstream ifs(path);
+  if (!ifs)
+    throw "ERROR: Cannot open baseline file!";
+  Results results;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    size_t q1 = line.find('"'), q2 = line.find("\": ");
+    if (q1 == std::string::npos || q2 == std::string::npos)
+      continue;
+    std::string value = line.substr(q2 + 3);
+    if (value.empty() || value[0] == '{')
+      continue;
+    results[line.substr(q1 + 1, q2 - q1 - 1)] = atof(value.c_str());
+  }
+  return results;
+}
+
+int main(int argc, char **argv) {
+  std::string out_path, baseline_path;
+  double threshold = 0.1;
+  bool quick = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--out" && i + 1 < argc)
+      out_path = argv[++i];
+    else if (arg == "--baseline" && i + 1 < argc)
+      baseline_path = argv[++i];
+    else if (arg == "--threshold" && i + 1 < argc)
+      threshold = atof(argv[++i]);
+    else if (arg == "--quick")
+      quick = true;
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--out results.json] [--baseline baseline.json]"
+                << " [--threshold 0.1] [--quick]" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Matrix of map sizes and obstacle densities
+  std::vector<BenchMap> maps = {{20.0f, 10.0f, 3.0f, 60, 30, 9},
+                                {40.0f, 20.0f, 3.0f, 120, 60, 9},
+                                {80.0f, 40.0f, 6.0f, 240, 120, 18}};
+  std::vector<float> densities = {0.1f, 0.5f};
+  size_t reps = 10;
+  if (quick) {
+    maps.resize(1);
+    reps = 3;
+  }
+
+  Results results;
+  try {
+    for (const BenchMap &cfg : maps) {
+      for (float density : densities) {
+        std::cerr << "Running " << cfg.nx << "x" << cfg.ny << "x" << cfg.nz
+                  << " at density " << density << std::endl;
+        bench_map(cfg, density, reps, results);
+      }
+    }
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  } catch (const std::string &err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Output
+  write_json(std::cout, results);
+  if (!out_path.empty()) {
+    std::ofstream ofs(out_path);
+    write_json(ofs, results);
+  }
+
+  // Comparison with a baseline
+  if (!baseline_path.empty()) {
+    Results baseline;
+    try {
+      baseline = read_json(baseline_path);
+    } catch (const char *err_msg) {
+      std::cerr << err_msg << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    size_t regressions = 0;
+    for (const auto &res : results) {
+      auto base = baseline.find(res.first);
+      if (base == baseline.end() || base->second <= 0.0 ||
+          (res.first.find("_ms") == std::string::npos &&
+           res.first.find("_us") == std::string::npos &&
+           res.first.find("_ns") == std::string::npos))
+        continue;
+      double ratio = res.second / base->second;
+      bool worse = ratio > 1.0 + threshold;
+      regressions += worse;
+      fprintf(stderr, "%-40s %12.4f %12.4f %7.2fx%s\n", res.first.c_str(),
+              base->second, res.second, ratio, worse ? "  REGRESSION" : "");
+    }
+    if (regressions > 0) {
+      std::cerr << regressions << " regressions above " << threshold * 100
+                << "%" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  return 0;
+}
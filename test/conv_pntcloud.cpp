@@ -0,0 +1,87 @@
+/**
+ * @file conv_pntcloud.cpp
+ * @brief Source file for the conversion of the pointclouds
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <boost/archive/binary_iarchive.hpp>
+#include <chrono>
+#include <fstream>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "CloudFile.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+
+// Check the extension of a path
+bool has_ext(const std::string &path, const std::string &ext) {
+  return path.size() >= ext.size() &&
+         path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0]
+              << " <input.dat|.ply|.pcd> <output.cld> [f32|f16|q16]"
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::string in_path = argv[1];
+  std::string out_path = argv[2];
+  nav::CloudEncoding encoding = nav::CLOUD_F32;
+  if (argc > 3 && std::string(argv[3]) == "f16")
+    encoding = nav::CLOUD_F16;
+  else if (argc > 3 && std::string(argv[3]) == "q16")
+    encoding = nav::CLOUD_Q16;
+
+  try {
+    // Import
+    auto start = std::chrono::steady_clock::now();
+    std::vector<nav::Point> pntcloud;
+    if (has_ext(in_path, ".ply")) {
+      nav::import_ply(in_path, pntcloud);
+    } else if (has_ext(in_path, ".pcd")) {
+      nav::import_pcd(in_path, pntcloud);
+    } else {
+      std::list<nav::Point> pnts;
+      std::ifstream ifs(in_path);
+      boost::archive::binary_iarchive ia(ifs);
+      ia >> pnts;
+      pntcloud.assign(pnts.begin(), pnts.end());
+    }
+    std::chrono::duration<double> import_time =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Imported " << pntcloud.size() << " points in "
+              << import_time.count() << " s" << std::endl;
+
+    // Convert
+    nav::CloudFile::write(out_path, pntcloud, encoding);
+
+    // Load back through mmap
+    start = std::chrono::steady_clock::now();
+    std::vector<nav::Point> loaded;
+    nav::CloudFile cloud(out_path);
+    cloud.read(loaded);
+    std::chrono::duration<double> load_time =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Loaded " << loaded.size() << " points (" << cloud.n_chunks()
+              << " chunks, " << cloud.size() << " bytes) in "
+              << load_time.count() << " s: "
+              << cloud.size() / load_time.count() / 1e9 << " GB/s on file, "
+              << loaded.size() * 3 * sizeof(float) / load_time.count() / 1e9
+              << " GB/s decoded" << std::endl;
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file explore.cpp
+ * @brief Source file for the headless explore-then-plan runner
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <cmath>
+#include <iostream>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Histogram.h"
+#include "Pipeline.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+  size_t max_ticks = 100000, seed = 0, lookahead = 3;
+  float range = 3.0f;
+  double period_ms = 0.0;
+  std::string world = "forest", trace_path;
+  bool sync = false, int_cost = false, stats = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--ticks" && i + 1 < argc)
+      max_ticks = atoi(argv[++i]);
+    else if (arg == "--seed" && i + 1 < argc)
+      seed = atoi(argv[++i]);
+    else if (arg == "--world" && i + 1 < argc)
+      world = argv[++i];
+    else if (arg == "--range" && i + 1 < argc)
+      range = atof(argv[++i]);
+    else if (arg == "--lookahead" && i + 1 < argc)
+      lookahead = atoi(argv[++i]);
+    else if (arg == "--period" && i + 1 < argc)
+      period_ms = atof(argv[++i]);
+    else if (arg == "--sync")
+      sync = true;
+    else if (arg == "--int-cost")
+      int_cost = true;
+    else if (arg == "--stats")
+      stats = true;
+    else if (arg == "--trace" && i + 1 < argc)
+      trace_path = argv[++i];
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--ticks N] [--seed N]"
+                << " [--world office|warehouse|forest|multistorey]"
+                << " [--range M] [--lookahead N] [--period MS] [--sync]"
+                << " [--int-cost] [--stats] [--trace trace.json]" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  try {
+    // Procedural world, known to both maps
+    nav::WorldParams params;
+    params.kind = nav::world_kind(world);
+    params.xlen = 40.0f;
+    params.ylen = 20.0f;
+    params.zlen = 3.0f;
+    params.seed = seed;
+    nav::WorldGen gen(params);
+    std::vector<nav::Point> pnts = gen.pntcloud(0.1f);
+    std::list<nav::Point> pntcloud(pnts.begin(), pnts.end());
+    nav::Planner planner(params.xlen, params.ylen, params.zlen, 120, 60, 9,
+                         0.5f, 0.25f, pntcloud);
+    planner.set_int_cost(int_cost);
+
+    // The explorer sees the obstacles at the flight height
+    float z = planner.boxes(planner.nz() / 2).cnt().z();
+    std::list<nav::Point> exp_pntcloud;
+    for (const nav::Point &pnt : pnts) {
+      if (fabs(pnt.z() - z) <= 0.25f)
+        exp_pntcloud.push_back(pnt);
+    }
+    nav::Explorer explorer(params.xlen, params.ylen, 40, 20, 0.5f,
+                           exp_pntcloud);
+
+    // Start from the first box free in both maps at the flight height
+    nav::Point str;
+    bool found = false;
+    for (size_t ind = planner.nz() / 2; ind < planner.n() && !found;
+         ind += planner.nz()) {
+      const nav::Box &box = planner.boxes(ind);
+      size_t exp_ind = explorer.pnt_to_ind(box.cnt());
+      if (box.is_free() && box.is_in() && exp_ind < explorer.boxes().size() &&
+          explorer.boxes(exp_ind).is_free()) {
+        str = box.cnt();
+        found = true;
+      }
+    }
+    if (!found)
+      throw "ERROR: No free box found!";
+
+    // Run
+    nav::Pipeline pipeline(planner, explorer, str, range, lookahead, !sync);
+    if (!trace_path.empty()) {
+      nav::trace::set_thread_name("Pipeline");
+      nav::trace::start();
+    }
+    nav::PipelineResult res = pipeline.run(max_ticks, period_ms);
+    if (!trace_path.empty()) {
+      nav::trace::stop();
+      size_t n_events = nav::trace::write(trace_path);
+      std::cout << n_events << " trace events written to " << trace_path
+                << std::endl;
+    }
+
+    // Summary
+    nav::LatencyHistogram tick_hist;
+    for (double ms : res.tick_ms)
+      tick_hist.record_ms(ms);
+    std::cout << (res.success ? "Explored" : "NOT explored") << " in "
+              << res.ticks << " ticks (" << res.moves << " moves, "
+              << res.stalls << " stalls), " << res.length << " m, "
+              << res.total_ms << " ms" << std::endl;
+    nav::Explorer explored = pipeline.explorer();
+    std::cout << "Goals: " << res.goals << " proposed, " << res.cancelled
+              << " cancelled, " << res.unreachable << " unreachable, "
+              << explored.frontier().size() << " frontier left" << std::endl;
+    if (tick_hist.count() > 0)
+      std::cout << "Tick latency: " << tick_hist.summary() << std::endl;
+    if (stats)
+      std::cout << explored.stats().to_json() << std::endl;
+    return res.success ? 0 : 1;
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+  } catch (const std::string &err_msg) {
+    std::cerr << err_msg << std::endl;
+  }
+  return 1;
+}
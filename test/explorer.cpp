@@ -8,19 +8,41 @@
 /*---------------------------------------------------------------------------*/
 /*                          Standard header includes                         */
 /*---------------------------------------------------------------------------*/
+#include <atomic>
 #include <boost/archive/binary_iarchive.hpp>
+#include <chrono>
 #include <fstream>
+#include <memory>
 #include <opencv2/opencv.hpp>
 #include <pangolin/display/display.h>
 #include <pangolin/display/view.h>
 #include <pangolin/gl/gldraw.h>
 #include <pangolin/handler/handler.h>
+#include <thread>
 
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
 #include "Drawer.h"
 #include "Explorer.h"
+#include "TripleBuffer.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+// Points added at one step, shared by all the scenes that follow
+typedef std::shared_ptr<const std::vector<nav::Point>> Block;
+
+// Scene published by the exploration thread. The explored boxes only grow,
+// so they are kept as the blocks of each step and the viewer appends the
+// new ones.
+struct Scene {
+  size_t tick;                      // Published scenes
+  nav::Point curr;                  // Center of the current box
+  std::vector<Block> explored;      // Centers of the explored boxes
+  std::vector<nav::Point> frontier; // Centers of the frontier boxes
+  Scene() : tick(0) {}
+};
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Definition                             */
@@ -65,14 +87,11 @@ int main() {
     ia >> explorer;
   }
 
-  std::list<size_t> exp_path;
+  std::list<size_t> goal_path;
   nav::Point str_pnt(8.5, 8.5, 2.0);
   size_t curr_ind = explorer.pnt_to_ind(str_pnt);
-  exp_path.push_front(curr_ind);
   explorer.set_explored(curr_ind);
 
-  size_t cnt = 0, fps = 50;
-
   pangolin::CreateWindowAndBind(window_name, window_width, window_height);
   glEnable(GL_DEPTH_TEST);
   glMatrixMode(GL_MODELVIEW);
@@ -95,12 +114,84 @@ int main() {
           .SetBounds(0.0, 1.0, 0.0, 1.0, (float)-window_width / window_height)
           .SetHandler(&handler);
 
+  // Map geometry, uploaded once and extended as the drone explores
+  gl::MeshBuffer box_buf(GL_TRIANGLES), link_buf(GL_LINES);
+  gl::MeshBuffer curr_buf(GL_TRIANGLES), explored_buf(GL_TRIANGLES);
+  gl::MeshBuffer frontier_buf(GL_TRIANGLES);
+  for (const nav::ExpBox &box : explorer.boxes()) {
+    if (!box.is_free())
+      box_buf.add_box(box.cnt(), exp_map_xstep, exp_map_ystep, drone_height);
+    for (nav::WtEdge edge : box.edges())
+      link_buf.add_link(box.cnt(), explorer.boxes(edge.first).cnt());
+  }
+
+  // Exploration thread, one box per step. A slow goal search delays the
+  // exploration but not the rendering.
+  const std::chrono::milliseconds step(800);
+  nav::TripleBuffer<Scene> scenes;
+  std::atomic<bool> quit(false);
+  std::thread exp_thread([&]() {
+    Scene scene;
+    std::vector<bool> drawn(explorer.boxes().size(), false);
+    // Publish the state of the exploration
+    auto publish = [&]() {
+      // Boxes explored since the last scene
+      std::vector<nav::Point> explored;
+      for (size_t ind = 0; ind < drawn.size(); ind++) {
+        if (!drawn[ind] && explorer.boxes(ind).is_explored()) {
+          explored.push_back(explorer.boxes(ind).cnt());
+          drawn[ind] = true;
+        }
+      }
+      if (!explored.empty())
+        scene.explored.emplace_back(
+            new std::vector<nav::Point>(std::move(explored)));
+      scene.tick++;
+      scene.curr = explorer.boxes(curr_ind).cnt();
+      scene.frontier.clear();
+      for (size_t ind : explorer.frontier())
+        scene.frontier.push_back(explorer.boxes(ind).cnt());
+      scenes.back() = scene;
+      scenes.publish();
+    };
+    publish();
+    auto next = std::chrono::steady_clock::now();
+    while (!quit) {
+      std::this_thread::sleep_until(next += step);
+      // Move towards the closest frontier box, one box per step
+      if (goal_path.empty())
+        explorer.next_goal(curr_ind, goal_path);
+      if (goal_path.empty())
+        break;
+      curr_ind = goal_path.front();
+      goal_path.pop_front();
+      explorer.set_explored(curr_ind);
+      publish();
+    }
+  });
+
+  size_t explored_seen = 0;
   while (!pangolin::ShouldQuit()) {
     // Clear screen and activate view to render into
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     d_cam.Activate(s_cam);
     glClearColor(1.0f, 1.0f, 1.0f, 0.2f);
 
+    // Take the last scene, only its new blocks are appended
+    if (scenes.update()) {
+      const Scene &scene = scenes.front();
+      for (; explored_seen < scene.explored.size(); explored_seen++) {
+        for (const nav::Point &cnt : *scene.explored[explored_seen])
+          explored_buf.add_box(cnt, exp_map_xstep, exp_map_ystep,
+                               drone_height);
+      }
+      curr_buf.clear();
+      curr_buf.add_box(scene.curr, exp_map_xstep, exp_map_ystep, drone_height);
+      frontier_buf.clear();
+      for (const nav::Point &cnt : scene.frontier)
+        frontier_buf.add_box(cnt, exp_map_xstep, exp_map_ystep, drone_height);
+    }
+
     // Origin
     gl::draw_axes();
 
@@ -110,76 +201,27 @@ int main() {
 
     // Boxes
     glColor4f(0.2f, 0.2f, 0.2f, 0.1f);
-    for (const nav::ExpBox &box : explorer.boxes()) {
-      if (!box.is_free())
-        gl::draw_box(box.cnt().x(), box.cnt().y(), box.cnt().z(), exp_map_xstep,
-                     exp_map_ystep, drone_height);
-    }
+    box_buf.draw();
 
     // Links
     glColor4f(0.2f, 0.2f, 0.2f, 0.2f);
-    for (const nav::ExpBox &src : explorer.boxes()) {
-      for (nav::WtEdge edge : src.edges()) {
-        nav::ExpBox dest = explorer.boxes(edge.first);
-        gl::draw_link(src.cnt().x(), src.cnt().y(), src.cnt().z(),
-                      dest.cnt().x(), dest.cnt().y(), dest.cnt().z());
-      }
-    }
+    link_buf.draw();
 
     // Path
     glColor4f(0.0f, 0.0f, 1.0f, 0.2f);
-    gl::draw_box(explorer.boxes(curr_ind).cnt().x(),
-                 explorer.boxes(curr_ind).cnt().y(),
-                 explorer.boxes(curr_ind).cnt().z(), exp_map_xstep,
-                 exp_map_ystep, drone_height);
+    curr_buf.draw();
     glColor4f(0.0f, 1.0f, 0.0f, 0.2f);
-    for (const nav::ExpBox &box : explorer.boxes()) {
-      if (box.is_explored())
-        gl::draw_box(box.cnt().x(), box.cnt().y(), box.cnt().z(), exp_map_xstep,
-                     exp_map_ystep, drone_height);
-    }
-
-    if ((cnt % fps) == 0) {
-      size_t min_score = -1;
-      float min_dist = INF;
-      size_t min_ind = -1;
-      for (nav::WtEdge edge : explorer.boxes(curr_ind).edges()) {
-        if (explorer.boxes(edge.first).is_explored())
-          continue;
-        size_t score = explorer.boxes(edge.first).f();
-        if (score < min_score) {
-          min_score = score;
-          min_dist = edge.second;
-          min_ind = edge.first;
-        } else if (score == min_score) {
-          if (edge.second < min_dist) {
-            min_score = score;
-            min_dist = edge.second;
-            min_ind = edge.first;
-          }
-        }
-      }
-      //
-      if (min_score == -1) {
-        for (size_t ind : exp_path) {
-          if (explorer.boxes(ind).f()) {
-            curr_ind = ind;
-            break;
-          }
-        }
-      } else {
-        //
-        curr_ind = min_ind;
-        exp_path.push_front(curr_ind);
-        explorer.set_explored(curr_ind);
-      }
-    }
-
-    cnt++;
+    explored_buf.draw();
+    // Frontier
+    glColor4f(1.0f, 0.5f, 0.0f, 0.2f);
+    frontier_buf.draw();
 
     // Swap frames and Process Events
     pangolin::FinishFrame();
   }
 
+  quit = true;
+  exp_thread.join();
+
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,193 @@
+/**
+ * @file fleet.cpp
+ * @brief Source file for the headless multi-drone runner
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Fleet.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+// Count the pairs of drones whose bodies overlap
+size_t count_collisions(const nav::Fleet &fleet,
+                        const std::vector<size_t> &inds) {
+  size_t collisions = 0;
+  for (size_t i = 0; i < inds.size(); i++) {
+    for (size_t j = i + 1; j < inds.size(); j++)
+      collisions += fleet.collide(inds[i], inds[j]);
+  }
+  return collisions;
+}
+
+int main(int argc, char **argv) {
+  size_t n_agents = 16, window = 16, max_steps = 2000, seed = 0;
+  size_t n_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::string world = "warehouse";
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--agents" && i + 1 < argc)
+      n_agents = atoi(argv[++i]);
+    else if (arg == "--window" && i + 1 < argc)
+      window = atoi(argv[++i]);
+    else if (arg == "--threads" && i + 1 < argc)
+      n_threads = atoi(argv[++i]);
+    else if (arg == "--steps" && i + 1 < argc)
+      max_steps = atoi(argv[++i]);
+    else if (arg == "--seed" && i + 1 < argc)
+      seed = atoi(argv[++i]);
+    else if (arg == "--world" && i + 1 < argc)
+      world = argv[++i];
+    else if (arg == "--verbose")
+      verbose = true;
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--agents N] [--window N] [--threads N] [--steps N]"
+                << " [--seed N]"
+                << " [--world office|warehouse|forest|multistorey]"
+                << " [--verbose]" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Procedural world, fully known to the drones
+  nav::Planner planner;
+  try {
+    nav::WorldParams params;
+    params.kind = nav::world_kind(world);
+    params.xlen = 40.0f;
+    params.ylen = 20.0f;
+    params.zlen = 3.0f;
+    params.seed = seed;
+    nav::WorldGen gen(params);
+    std::vector<nav::Point> pntcloud = gen.pntcloud(0.1f, n_threads);
+    planner = nav::Planner(params.xlen, params.ylen, params.zlen, 120, 60, 9,
+                           0.5f, 0.25f,
+                           std::list<nav::Point>(pntcloud.begin(),
+                                                 pntcloud.end()));
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  } catch (const std::string &err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Random drones between free boxes, the ones too close to the previous
+  // drones or without a route are drawn again
+  std::vector<size_t> free_boxes;
+  for (size_t ind = 0; ind < planner.n(); ind++) {
+    if (planner.boxes(ind).is_free() && planner.boxes(ind).is_in())
+      free_boxes.push_back(ind);
+  }
+  if (free_boxes.empty()) {
+    std::cerr << "ERROR: No free box found!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, free_boxes.size() - 1);
+  std::vector<size_t> starts;
+  std::vector<nav::Fleet> fleets;
+  fleets.emplace_back(planner, window, 1);
+  fleets.emplace_back(planner, window, n_threads);
+  for (size_t tries = 0;
+       fleets[0].agents().size() < n_agents && tries < 100 * n_agents;
+       tries++) {
+    nav::Point str = planner.boxes(free_boxes[pick(rng)]).cnt();
+    nav::Point trg = planner.boxes(free_boxes[pick(rng)]).cnt();
+    try {
+      fleets[0].add_agent(str, trg);
+      fleets[1].add_agent(str, trg);
+      starts.push_back(planner.pnt_to_ind(str));
+    } catch (const char *err_msg) {
+      continue;
+    }
+  }
+
+  // Fly both fleets and check that the bodies never overlap
+  std::vector<double> elapsed(fleets.size());
+  std::vector<size_t> collisions(fleets.size(), 0);
+  for (size_t f = 0; f < fleets.size(); f++) {
+    nav::Fleet &fleet = fleets[f];
+    auto start = std::chrono::steady_clock::now();
+    while (fleet.time() < max_steps && fleet.step()) {
+      std::vector<size_t> inds;
+      for (const nav::Agent &agent : fleet.agents())
+        inds.push_back(agent.str);
+      collisions[f] += count_collisions(fleet, inds);
+    }
+    elapsed[f] = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  }
+
+  // Same drones on their own shortest routes, as if nobody deconflicted them
+  std::vector<std::vector<size_t>> routes;
+  for (size_t i = 0; i < starts.size(); i++) {
+    const nav::Agent &agent = fleets[0].agents()[i];
+    std::vector<size_t> route(1, starts[i]);
+    while (route.back() != agent.trg) {
+      for (const nav::WtEdge &edge : planner.boxes(route.back()).edges()) {
+        if (agent.dist[edge.first] + 1 == agent.dist[route.back()]) {
+          route.push_back(edge.first);
+          break;
+        }
+      }
+    }
+    routes.push_back(route);
+  }
+  size_t solo_collisions = 0, solo_steps = 0;
+  for (const std::vector<size_t> &route : routes)
+    solo_steps = std::max(solo_steps, route.size() - 1);
+  for (size_t t = 1; t <= solo_steps; t++) {
+    std::vector<size_t> inds;
+    for (const std::vector<size_t> &route : routes)
+      inds.push_back(route[std::min(t, route.size() - 1)]);
+    solo_collisions += count_collisions(fleets[0], inds);
+  }
+
+  // Summary
+  for (size_t f = 0; f < fleets.size(); f++) {
+    const nav::Fleet &fleet = fleets[f];
+    size_t arrived = 0, moves = 0, waits = 0;
+    for (size_t i = 0; i < fleet.agents().size(); i++) {
+      const nav::Agent &agent = fleet.agents()[i];
+      arrived += agent.arrived();
+      moves += agent.moves;
+      waits += agent.waits;
+      if (verbose && f == 0)
+        std::cout << "Agent " << i << ": " << agent.moves << " moves, "
+                  << agent.waits << " waits"
+                  << (agent.arrived() ? "" : " NOT ARRIVED") << std::endl;
+    }
+    std::cout << (f == 0 ? "Sequential: " : "Parallel:   ") << arrived << "/"
+              << fleet.agents().size() << " drones arrived in "
+              << fleet.time() << " steps, " << moves << " moves, " << waits
+              << " waits, " << fleet.failures() << " failed plans, "
+              << fleet.kept() << " kept plans, " << collisions[f]
+              << " collisions, " << elapsed[f] << " ms on "
+              << (f == 0 ? 1 : n_threads) << " threads" << std::endl;
+  }
+
+  std::cout << "Uncoordinated: " << solo_steps << " steps, " << solo_collisions
+            << " collisions" << std::endl;
+
+  return (collisions[0] == 0 && collisions[1] == 0 && fleets[0].done() &&
+          fleets[1].done())
+             ? 0
+             : 1;
+}
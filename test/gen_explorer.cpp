@@ -17,6 +17,7 @@
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
 #include "Explorer.h"
+#include "MapFile.h"
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Definition                             */
@@ -74,6 +75,12 @@ int main() {
     boost::archive::binary_oarchive oa(ofs);
     oa << explorer;
   }
+  try {
+    nav::MapFile::write("../data/explorer.map", explorer);
+  } catch (const char *msg) {
+    std::cerr << msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   return 0;
 }
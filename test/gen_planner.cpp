@@ -16,6 +16,7 @@
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
+#include "MapFile.h"
 #include "Planner.h"
 
 /*---------------------------------------------------------------------------*/
@@ -86,6 +87,12 @@ int main() {
     boost::archive::binary_oarchive oa(ofs);
     oa << planner;
   }
+  try {
+    nav::MapFile::write("../data/planner.map", planner, true);
+  } catch (const char *msg) {
+    std::cerr << msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   nav::Planner empty_planner;
   std::list<nav::Point> empty_pntcloud;
@@ -102,6 +109,12 @@ int main() {
     boost::archive::binary_oarchive oa(ofs);
     oa << empty_planner;
   }
+  try {
+    nav::MapFile::write("../data/empty_planner.map", empty_planner);
+  } catch (const char *msg) {
+    std::cerr << msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   return 0;
 }
@@ -16,6 +16,7 @@
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
+#include "CloudFile.h"
 #include "Point.h"
 
 /*---------------------------------------------------------------------------*/
@@ -175,6 +176,12 @@ int main() {
     boost::archive::binary_oarchive oa(ofs);
     oa << nav_fix_pntcloud;
   }
+  try {
+    nav::CloudFile::write("../data/nav_fix_pntcloud.cld", nav_fix_pntcloud);
+  } catch (const char *msg) {
+    std::cerr << msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   std::list<nav::Point> exp_fix_pntcloud;
   for (std::pair<nav::Point, nav::Point> &obs : exp_fix_obstacles) {
@@ -215,6 +222,12 @@ int main() {
     boost::archive::binary_oarchive oa(ofs);
     oa << slam_pntcloud;
   }
+  try {
+    nav::CloudFile::write("../data/slam_pntcloud.cld", slam_pntcloud);
+  } catch (const char *msg) {
+    std::cerr << msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   std::list<nav::Point> total_pntcloud;
   for (std::pair<nav::Point, nav::Point> &obs : nav_fix_obstacles) {
@@ -242,6 +255,12 @@ int main() {
     boost::archive::binary_oarchive oa(ofs);
     oa << total_pntcloud;
   }
+  try {
+    nav::CloudFile::write("../data/total_pntcloud.cld", total_pntcloud);
+  } catch (const char *msg) {
+    std::cerr << msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   return 0;
 }
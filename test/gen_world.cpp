@@ -0,0 +1,87 @@
+/**
+ * @file gen_world.cpp
+ * @brief Source file for the generation of procedural worlds
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <chrono>
+#include <opencv2/opencv.hpp>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "CloudFile.h"
+#include "MapFile.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+  if (argc < 5) {
+    std::cerr << "Usage: " << argv[0]
+              << " <office|warehouse|forest|multistorey> <xlen> <ylen> <zlen>"
+              << " [seed] [density] [res] [pntcloud|occupancy]" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Load config file
+  cv::FileStorage fs;
+  fs.open("../config/map_config.yaml", cv::FileStorage::READ);
+  // Drone config
+  cv::FileNode drone_cfg = fs["drone"];
+  float drone_radius = (float)drone_cfg["radius"];
+  float drone_height = (float)drone_cfg["height"];
+
+  try {
+    // World config
+    nav::WorldParams params;
+    params.kind = nav::world_kind(argv[1]);
+    params.xlen = atof(argv[2]);
+    params.ylen = atof(argv[3]);
+    params.zlen = atof(argv[4]);
+    params.seed = (argc > 5) ? atoi(argv[5]) : 0;
+    params.density = (argc > 6) ? atof(argv[6]) : 0.5f;
+    float res = (argc > 7) ? atof(argv[7]) : 0.1f;
+    std::string output = (argc > 8) ? argv[8] : "pntcloud";
+    size_t n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+    nav::WorldGen world(params);
+    std::cout << "Generated " << world.obstacles().size() << " obstacles"
+              << std::endl;
+
+    if (output == "occupancy") {
+      // Rasterize directly on the navigation grid
+      size_t nx = (size_t)ceil(params.xlen / res);
+      size_t ny = (size_t)ceil(params.ylen / res);
+      size_t nz = (size_t)ceil(params.zlen / res);
+      std::vector<uint8_t> occupancy = world.occupancy(nx, ny, nz, n_threads);
+      nav::Planner planner(params.xlen, params.ylen, params.zlen, nx, ny, nz,
+                           drone_radius, drone_height, occupancy);
+      nav::MapFile::write("../data/world_planner.map", planner);
+      std::cout << "Wrote " << nx * ny * nz << " boxes";
+    } else {
+      // Sample the surfaces of the obstacles
+      std::vector<nav::Point> pntcloud = world.pntcloud(res, n_threads);
+      nav::CloudFile::write("../data/world_pntcloud.cld", pntcloud);
+      std::cout << "Wrote " << pntcloud.size() << " points";
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << " in " << elapsed.count() << " s" << std::endl;
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  } catch (const std::string &err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  return 0;
+}
@@ -8,19 +8,44 @@
 /*---------------------------------------------------------------------------*/
 /*                          Standard header includes                         */
 /*---------------------------------------------------------------------------*/
+#include <atomic>
 #include <boost/archive/binary_iarchive.hpp>
+#include <chrono>
 #include <fstream>
+#include <memory>
 #include <opencv2/opencv.hpp>
 #include <pangolin/display/display.h>
 #include <pangolin/display/view.h>
 #include <pangolin/gl/gldraw.h>
 #include <pangolin/handler/handler.h>
+#include <thread>
 
 /*---------------------------------------------------------------------------*/
 /*                          Project header includes                          */
 /*---------------------------------------------------------------------------*/
 #include "Drawer.h"
-#include "Planner.h"
+#include "MapFile.h"
+#include "Simulator.h"
+#include "TripleBuffer.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Class Definition                             */
+/*---------------------------------------------------------------------------*/
+// Points added at one step, shared by all the scenes that follow
+typedef std::shared_ptr<const std::vector<nav::Point>> Block;
+
+// Scene published by the simulation thread. The map only grows, so it is
+// kept as the blocks of each step and the viewer appends the new ones.
+struct Scene {
+  size_t tick;                    // Published scenes
+  bool done;                      // Target reached
+  std::vector<Block> slam;        // SLAM points kept by the planner
+  std::vector<Block> busy;        // Centers of the busy boxes
+  nav::Point drone;               // Center of the drone
+  std::vector<nav::Point> path;   // Centers of the path, or of the flown one
+  std::vector<nav::Point> bounds; // Sensor footprint
+  Scene() : tick(0), done(false) {}
+};
 
 /*---------------------------------------------------------------------------*/
 /*                              Main Definition                             */
@@ -58,19 +83,19 @@ int main() {
   double window_zview = (double)window_cfg["zview"];
   double window_xstart = (double)window_cfg["xstart"];
   double window_ystart = (double)window_cfg["ystart"];
+  // Chunks, coarse cells as multiples of the boxes and their distance
+  float window_chunk = (float)window_cfg["chunk"];
+  float window_cell = (int)window_cfg["lod"] * nav_map_xstep;
+  float window_lod_dist = (float)window_cfg["lod_dist"];
 
   nav::Planner planner;
-  {
-    std::ifstream ifs("../data/planner.dat");
-    boost::archive::binary_iarchive ia(ifs);
-    ia >> planner;
-  }
-
   nav::Planner empty_planner;
-  {
-    std::ifstream ifs("../data/empty_planner.dat");
-    boost::archive::binary_iarchive ia(ifs);
-    ia >> empty_planner;
+  try {
+    nav::MapFile("../data/planner.map").load(planner, true);
+    nav::MapFile("../data/empty_planner.map").load(empty_planner);
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
   }
 
   std::list<nav::Point> slam_pntcloud;
@@ -90,25 +115,16 @@ int main() {
   nav::Point str_pnt(17.5, 4.5, 1.5);
   nav::Point trg_pnt(2.5, 2.5, 1.5);
 
-  std::list<size_t> path_from;
-  std::list<size_t> path_to;
+  nav::PointGrid world(std::vector<nav::Point>(total_pntcloud.begin(),
+                                               total_pntcloud.end()));
+  nav::Simulator sim(planner, world);
   try {
-    planner.set_str(trg_pnt);
-    planner.set_trg(str_pnt);
-    planner.search();
-    path_to = planner.path();
+    sim.start(trg_pnt, str_pnt);
   } catch (const char *err_msg) {
     std::cerr << err_msg << std::endl;
     exit(EXIT_FAILURE);
   }
 
-  size_t curr_ind, next_ind;
-  nav::Point curr_pnt, next_pnt;
-  double yaw;
-  size_t cnt = 0, fps = 50;
-  nav::Point p1, p2, p3, p4;
-  std::vector<nav::Point> bounds;
-
   pangolin::CreateWindowAndBind(window_name, window_width, window_height);
   glEnable(GL_DEPTH_TEST);
   glMatrixMode(GL_MODELVIEW);
@@ -131,47 +147,115 @@ int main() {
           .SetBounds(0.0, 1.0, 0.0, 1.0, (float)-window_width / window_height)
           .SetHandler(&handler);
 
+  // Map geometry in chunks, uploaded once and extended as the map changes
+  gl::Frustum frustum;
+  gl::ChunkGrid fix_grid(GL_POINTS, nav_map_xlen, nav_map_ylen, window_chunk,
+                         window_cell, window_lod_dist);
+  gl::ChunkGrid slam_grid(GL_POINTS, nav_map_xlen, nav_map_ylen, window_chunk,
+                          window_cell, window_lod_dist);
+  gl::ChunkGrid box_grid(GL_TRIANGLES, nav_map_xlen, nav_map_ylen, window_chunk,
+                         window_cell, window_lod_dist);
+  gl::MeshBuffer str_buf(GL_TRIANGLES), path_buf(GL_TRIANGLES);
+  for (const nav::Box &box : sim.planner().boxes()) {
+    for (const nav::Point &pnt : box.fix_pnts())
+      fix_grid.add_point(pnt);
+    for (const nav::Point &pnt : box.slam_pnts())
+      slam_grid.add_point(pnt);
+  }
+
+  // Simulation thread, one step is a sense and a move half a step later. A
+  // slow update delays the simulation but not the rendering.
+  const std::chrono::milliseconds half_step(400);
+  nav::TripleBuffer<Scene> scenes;
+  std::atomic<bool> quit(false);
+  std::thread sim_thread([&]() {
+    Scene scene;
+    std::vector<bool> drawn(sim.planner().n(), false);
+    std::vector<nav::Point> path_from;
+    // Publish the state of the simulation
+    auto publish = [&]() {
+      const nav::Planner &planner = sim.planner();
+      // Boxes set busy since the last scene
+      std::vector<nav::Point> busy;
+      for (size_t ind = 0; ind < planner.n(); ind++) {
+        if (!drawn[ind] && !planner.boxes(ind).is_free()) {
+          busy.push_back(planner.boxes(ind).cnt());
+          drawn[ind] = true;
+        }
+      }
+      if (!busy.empty())
+        scene.busy.emplace_back(new std::vector<nav::Point>(std::move(busy)));
+      scene.tick++;
+      scene.done = sim.done();
+      scene.drone = planner.boxes(planner.str()).cnt();
+      scene.path.clear();
+      if (!scene.done) {
+        for (size_t ind : planner.path())
+          scene.path.push_back(planner.boxes(ind).cnt());
+      } else {
+        scene.path = path_from;
+      }
+      scene.bounds = sim.bounds();
+      scenes.back() = scene;
+      scenes.publish();
+    };
+    publish();
+    auto next = std::chrono::steady_clock::now();
+    try {
+      while (!quit && !sim.done()) {
+        // Only the SLAM points kept by the planner are drawn
+        std::vector<nav::Point> slam;
+        for (const nav::Point &pnt : sim.sense()) {
+          size_t ind = sim.planner().pnt_to_ind(pnt);
+          if (ind < sim.planner().n() && sim.planner().is_updatable(ind))
+            slam.push_back(pnt);
+        }
+        scene.slam.emplace_back(new std::vector<nav::Point>(std::move(slam)));
+        std::cout << sim.planner().boxes(sim.planner().str()).cnt() << " : "
+                  << sim.yaw() << " (" << sim.step_ms().back() << " ms)"
+                  << std::endl;
+        publish();
+        std::this_thread::sleep_until(next += half_step);
+        if (quit || sim.done())
+          break;
+        path_from.push_back(scene.drone);
+        sim.move();
+        publish();
+        std::this_thread::sleep_until(next += half_step);
+      }
+    } catch (const char *err_msg) {
+      std::cerr << err_msg << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  });
+
+  size_t slam_seen = 0, busy_seen = 0;
   while (!pangolin::ShouldQuit()) {
     // Clear screen and activate view to render into
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     d_cam.Activate(s_cam);
+    frustum.update();
     glClearColor(1.0f, 1.0f, 1.0f, 0.2f);
 
-    if ((cnt % fps) == 0) {
-      if (curr_ind != planner.trg()) {
-        try {
-          curr_ind = planner.str();
-          curr_pnt = planner.boxes(curr_ind).cnt();
-          next_ind = planner.path().front();
-          next_pnt = planner.boxes(next_ind).cnt();
-          if ((curr_pnt.x() != next_pnt.x()) || (curr_pnt.y() != next_pnt.y()))
-            yaw = curr_pnt.angle_xy(next_pnt);
-          std::cout << curr_pnt << " -> " << next_pnt << " : " << yaw
-                    << std::endl;
-          //
-          p1.set(curr_pnt.x() - 1.0f, curr_pnt.y() - 1.0f, curr_pnt.z());
-          p1.rotate_xy(curr_pnt, yaw);
-          p2.set(curr_pnt.x() + 3.0f, curr_pnt.y() - 1.0f, curr_pnt.z());
-          p2.rotate_xy(curr_pnt, yaw);
-          p3.set(curr_pnt.x() + 3.0f, curr_pnt.y() + 1.0f, curr_pnt.z());
-          p3.rotate_xy(curr_pnt, yaw);
-          p4.set(curr_pnt.x() - 1.0f, curr_pnt.y() + 1.0f, curr_pnt.z());
-          p4.rotate_xy(curr_pnt, yaw);
-          bounds = {p1, p2, p3, p4};
-          std::list<nav::Point> pntcloud;
-          for (nav::Point &pnt : total_pntcloud) {
-            if (pnt.is_inside_xy(bounds) && abs(curr_pnt.z() - pnt.z()) <= 1.0f)
-              pntcloud.push_back(pnt);
-          }
-          //
-          planner.update(pntcloud);
-          path_to = planner.path();
-        } catch (const char *err_msg) {
-          std::cerr << err_msg << std::endl;
-          exit(EXIT_FAILURE);
-        }
+    // Take the last scene, only its new blocks are appended
+    if (scenes.update()) {
+      const Scene &scene = scenes.front();
+      for (; slam_seen < scene.slam.size(); slam_seen++) {
+        for (const nav::Point &pnt : *scene.slam[slam_seen])
+          slam_grid.add_point(pnt);
+      }
+      for (; busy_seen < scene.busy.size(); busy_seen++) {
+        for (const nav::Point &cnt : *scene.busy[busy_seen])
+          box_grid.add_box(cnt, nav_map_xstep, nav_map_ystep, nav_map_zstep);
       }
+      str_buf.clear();
+      path_buf.clear();
+      if (!scene.done)
+        str_buf.add_cylinder(scene.drone, drone_radius, drone_height);
+      for (const nav::Point &cnt : scene.path)
+        path_buf.add_cylinder(cnt, drone_radius, drone_height);
     }
+    const Scene &scene = scenes.front();
 
     // Origin
     gl::draw_axes();
@@ -182,72 +266,34 @@ int main() {
 
     // Fixed points
     glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Box &box : planner.boxes()) {
-      for (const nav::Point &pnt : box.fix_pnts()) {
-        glVertex3f(pnt.x(), pnt.y(), pnt.z());
-      }
-    }
-    glEnd();
+    fix_grid.draw(frustum);
     // SLAM points
     glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Box &box : planner.boxes()) {
-      for (const nav::Point &pnt : box.slam_pnts()) {
-        glVertex3f(pnt.x(), pnt.y(), pnt.z());
-      }
-    }
-    glEnd();
+    slam_grid.draw(frustum);
 
     // Boxes
     glColor4f(0.2f, 0.2f, 0.2f, 0.1f);
-    for (const nav::Box &box : planner.boxes()) {
-      if (!box.is_free())
-        gl::draw_box(box.cnt().x(), box.cnt().y(), box.cnt().z(), nav_map_xstep,
-                     nav_map_ystep, nav_map_zstep);
-    }
+    box_grid.draw(frustum);
 
-    //
-    glColor4f(0.0f, 0.0f, 1.0f, 0.2f);
-    gl::draw_polyhedron(p1, p2, p3, p4, 1.0f);
-
-    // Path
-    if (curr_ind != planner.trg()) {
+    // Sensor footprint
+    const std::vector<nav::Point> &bounds = scene.bounds;
+    if (bounds.size() == 4) {
       glColor4f(0.0f, 0.0f, 1.0f, 0.2f);
-      nav::Box box = planner.boxes(curr_ind);
-      gl::draw_cylinder(box.cnt().x(), box.cnt().y(), box.cnt().z(),
-                        drone_radius, drone_height);
-      glColor4f(0.0f, 1.0f, 0.0f, 0.2f);
-      for (size_t ind : path_to) {
-        nav::Box box = planner.boxes(ind);
-        gl::draw_cylinder(box.cnt().x(), box.cnt().y(), box.cnt().z(),
-                          drone_radius, drone_height);
-      }
-    } else {
-      glColor4f(0.0f, 1.0f, 0.0f, 0.2f);
-      for (size_t ind : path_from) {
-        nav::Box box = planner.boxes(ind);
-        gl::draw_cylinder(box.cnt().x(), box.cnt().y(), box.cnt().z(),
-                          drone_radius, drone_height);
-      }
+      gl::draw_polyhedron(bounds[0], bounds[1], bounds[2], bounds[3], 1.0f);
     }
 
-    if ((cnt % fps) == (fps / 2)) {
-      if (curr_ind != planner.trg()) {
-        try {
-          path_from.push_back(curr_ind);
-          planner.move();
-        } catch (const char *err_msg) {
-          std::cerr << err_msg << std::endl;
-          exit(EXIT_FAILURE);
-        }
-      }
-    }
+    // Path
+    glColor4f(0.0f, 0.0f, 1.0f, 0.2f);
+    str_buf.draw();
+    glColor4f(0.0f, 1.0f, 0.0f, 0.2f);
+    path_buf.draw();
 
     // Swap frames and Process Events
     pangolin::FinishFrame();
-    cnt++;
   }
 
+  quit = true;
+  sim_thread.join();
+
   return 0;
 }
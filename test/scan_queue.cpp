@@ -0,0 +1,228 @@
+/**
+ * @file scan_queue.cpp
+ * @brief Source file for the stress test of the SLAM batch queue
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "Planner.h"
+#include "Stats.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+typedef std::chrono::steady_clock::time_point TimePoint;
+
+// Print the percentiles of a set of latencies
+static void print_latency(const std::string &name, std::vector<double> us) {
+  if (us.empty())
+    return;
+  std::sort(us.begin(), us.end());
+  std::cout << name << ": p50 " << us[us.size() / 2] << " us, p99 "
+            << us[us.size() * 99 / 100] << " us, max " << us.back() << " us"
+            << std::endl;
+}
+
+// Push the batches from the producer thread, retry while the ring is full
+// unless drop is set. The stamp of a batch is written before it is pushed,
+// so the consumer sees it once the batch is out.
+static void produce(nav::ScanQueue &queue,
+                    const std::vector<std::vector<nav::Point>> &batches,
+                    std::vector<TimePoint> &stamps, bool drop,
+                    std::atomic<bool> &done) {
+  for (size_t i = 0; i < batches.size(); i++) {
+    stamps[i] = std::chrono::steady_clock::now();
+    while (!queue.push(batches[i]) && !drop) {
+      std::this_thread::yield();
+      stamps[i] = std::chrono::steady_clock::now();
+    }
+  }
+  done.store(true, std::memory_order_release);
+}
+
+int main(int argc, char **argv) {
+  size_t n_batches = 100000, n_slots = 64, slot_size = 256, seed = 0;
+  double period_ms = 0.0;
+  bool drop = false, planner_mode = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--batches" && i + 1 < argc)
+      n_batches = atoi(argv[++i]);
+    else if (arg == "--slots" && i + 1 < argc)
+      n_slots = atoi(argv[++i]);
+    else if (arg == "--slot-size" && i + 1 < argc)
+      slot_size = atoi(argv[++i]);
+    else if (arg == "--period" && i + 1 < argc)
+      period_ms = atof(argv[++i]);
+    else if (arg == "--seed" && i + 1 < argc)
+      seed = atoi(argv[++i]);
+    else if (arg == "--drop")
+      drop = true;
+    else if (arg == "--planner")
+      planner_mode = true;
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--batches N] [--slots N] [--slot-size N] [--period MS]"
+                << " [--seed N] [--drop] [--planner]" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  try {
+    // Scans are never dropped in planner mode, the map is checked at the end
+    if (planner_mode)
+      drop = false;
+    nav::ScanQueue queue(n_slots, slot_size);
+    std::vector<std::vector<nav::Point>> batches;
+    nav::Planner planner, reference, empty;
+    if (planner_mode) {
+      // Scans of a procedural world, unknown to the planner
+      nav::WorldParams params;
+      params.xlen = 40.0f;
+      params.ylen = 20.0f;
+      params.zlen = 3.0f;
+      params.seed = seed;
+      std::vector<nav::Point> pnts = nav::WorldGen(params).pntcloud(0.1f);
+      for (size_t i = 0; i < pnts.size(); i += slot_size) {
+        batches.push_back(std::vector<nav::Point>(
+            pnts.begin() + i, pnts.begin() + std::min(i + slot_size,
+                                                      pnts.size())));
+      }
+      planner = nav::Planner(params.xlen, params.ylen, params.zlen, 120, 60, 9,
+                             0.5f, 0.25f, std::list<nav::Point>());
+      empty = planner;
+      reference = planner;
+      reference.update(std::list<nav::Point>(pnts.begin(), pnts.end()));
+    } else {
+      // Batches of up to three slots, each point tells its batch and position
+      for (size_t i = 0; i < n_batches; i++) {
+        size_t n = 1 + (i * 2654435761u + seed) % (3 * slot_size);
+        std::vector<nav::Point> batch;
+        for (size_t j = 0; j < n; j++)
+          batch.push_back(nav::Point(i, j, n));
+        batches.push_back(batch);
+      }
+    }
+
+    // Consume while the producer runs
+    std::vector<TimePoint> stamps(batches.size());
+    std::vector<double> latency_us, drain_us;
+    std::vector<nav::Point> pnts;
+    pnts.reserve(4 * n_slots * slot_size);
+    size_t n_pnts = 0, n_drains = 0, n_recv = 0, errors = 0, next = 0;
+    size_t next_pnt = 0;
+    std::atomic<bool> done(false);
+    TimePoint start = std::chrono::steady_clock::now(), tick = start;
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(period_ms));
+    std::thread producer(produce, std::ref(queue), std::cref(batches),
+                         std::ref(stamps), drop, std::ref(done));
+    while (true) {
+      // The last drain after the producer is done gets all the batches
+      bool finished = done.load(std::memory_order_acquire);
+      TimePoint drain_start = std::chrono::steady_clock::now();
+      size_t n_popped;
+      if (planner_mode) {
+        // All the waiting scans go in one update, a scan fills one slot
+        n_popped = planner.update(queue);
+        n_recv += n_popped;
+        TimePoint now = std::chrono::steady_clock::now();
+        for (size_t k = 0; k < n_popped; k++, next++)
+          latency_us.push_back(
+              std::chrono::duration<double, std::micro>(now - stamps[next])
+                  .count());
+      } else {
+        pnts.clear();
+        n_popped = queue.drain(pnts);
+        // Check the order of the points, a new batch starts at position zero
+        TimePoint now = std::chrono::steady_clock::now();
+        for (const nav::Point &pnt : pnts) {
+          if (pnt.y() == 0.0f) {
+            if (drop ? (size_t)pnt.x() < next : (size_t)pnt.x() != next)
+              errors++;
+            next = (size_t)pnt.x() + 1;
+            next_pnt = 0;
+            n_recv++;
+            latency_us.push_back(std::chrono::duration<double, std::micro>(
+                                     now - stamps[(size_t)pnt.x()])
+                                     .count());
+          }
+          if ((size_t)pnt.y() != next_pnt++ || pnt.z() <= pnt.y())
+            errors++;
+        }
+        n_pnts += pnts.size();
+      }
+      if (n_popped > 0) {
+        drain_us.push_back(nav::elapsed_ms(drain_start) * 1e3);
+        n_drains++;
+      }
+      if (finished)
+        break;
+      if (period_ms > 0.0) {
+        tick += period;
+        std::this_thread::sleep_until(tick);
+      } else if (n_popped == 0) {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    double total_ms = nav::elapsed_ms(start);
+
+    // Summary, without drops the rejected pushes are retries
+    size_t n_lost = drop ? queue.rejected() : 0;
+    size_t n_pushed = batches.size() - n_lost;
+    if (n_recv != n_pushed)
+      errors++;
+    std::cout << n_pushed << " batches (" << n_lost << " dropped, "
+              << queue.rejected() << " pushes on a full ring) in " << total_ms
+              << " ms, " << n_pushed / total_ms * 1e3 << " batches/s";
+    if (!planner_mode)
+      std::cout << ", " << n_pnts / total_ms * 1e3 << " points/s";
+    std::cout << std::endl;
+    std::cout << n_recv << " batches received in " << n_drains << " drains, "
+              << (double)n_recv / std::max<size_t>(n_drains, 1)
+              << " batches per drain" << std::endl;
+    print_latency("Push to " + std::string(planner_mode ? "update" : "drain"),
+                  latency_us);
+    print_latency(planner_mode ? "Update" : "Drain", drain_us);
+    if (planner_mode) {
+      // One update per drain must give the same map as a single update
+      for (size_t ind = 0; ind < planner.n(); ind++) {
+        if (planner.boxes(ind).is_free() != reference.boxes(ind).is_free())
+          errors++;
+      }
+      std::cout << errors << " boxes differ from a single update" << std::endl;
+      // Cost of one update per scan against the coalesced updates
+      nav::Planner single(empty);
+      TimePoint single_start = std::chrono::steady_clock::now();
+      for (const std::vector<nav::Point> &batch : batches)
+        single.update(std::list<nav::Point>(batch.begin(), batch.end()));
+      double single_ms = nav::elapsed_ms(single_start), update_ms = 0.0;
+      for (double us : drain_us)
+        update_ms += us / 1e3;
+      std::cout << "Update time: " << update_ms << " ms coalesced, "
+                << single_ms << " ms with one update per scan" << std::endl;
+    } else {
+      std::cout << errors << " points out of order" << std::endl;
+    }
+    return errors == 0 ? 0 : 1;
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+  } catch (const std::string &err_msg) {
+    std::cerr << err_msg << std::endl;
+  }
+  return 1;
+}
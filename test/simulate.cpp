@@ -0,0 +1,185 @@
+/**
+ * @file simulate.cpp
+ * @brief Source file for the headless mission runner
+ * @date 19 October 2026
+ * @author Alessandro Tenaglia
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                          Standard header includes                         */
+/*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*                          Project header includes                          */
+/*---------------------------------------------------------------------------*/
+#include "CloudFile.h"
+#include "MapFile.h"
+#include "PointGrid.h"
+#include "Simulator.h"
+#include "WorldGen.h"
+
+/*---------------------------------------------------------------------------*/
+/*                              Main Definition                              */
+/*---------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+  size_t n_missions = 100, max_steps = 10000, seed = 0;
+  size_t n_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::string map_path, cloud_path, trace_path, world = "forest";
+  bool verbose = false, int_cost = false, stats = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--missions" && i + 1 < argc)
+      n_missions = atoi(argv[++i]);
+    else if (arg == "--threads" && i + 1 < argc)
+      n_threads = atoi(argv[++i]);
+    else if (arg == "--steps" && i + 1 < argc)
+      max_steps = atoi(argv[++i]);
+    else if (arg == "--seed" && i + 1 < argc)
+      seed = atoi(argv[++i]);
+    else if (arg == "--map" && i + 1 < argc)
+      map_path = argv[++i];
+    else if (arg == "--cloud" && i + 1 < argc)
+      cloud_path = argv[++i];
+    else if (arg == "--world" && i + 1 < argc)
+      world = argv[++i];
+    else if (arg == "--int-cost")
+      int_cost = true;
+    else if (arg == "--verbose")
+      verbose = true;
+    else if (arg == "--stats")
+      stats = true;
+    else if (arg == "--trace" && i + 1 < argc)
+      trace_path = argv[++i];
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--missions N] [--threads N] [--steps N] [--seed N]"
+                << " [--map planner.map --cloud total_pntcloud.cld]"
+                << " [--world office|warehouse|forest|multistorey]"
+                << " [--int-cost] [--verbose] [--stats]"
+                << " [--trace trace.json]" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  nav::Planner planner;
+  std::vector<nav::Point> pntcloud;
+  try {
+    if (!map_path.empty() && !cloud_path.empty()) {
+      // Saved map and world
+      nav::MapFile(map_path).load(planner);
+      nav::CloudFile(cloud_path).read(pntcloud);
+    } else {
+      // Procedural world, half of the obstacles are only seen by the sensor
+      nav::WorldParams params;
+      params.kind = nav::world_kind(world);
+      params.xlen = 40.0f;
+      params.ylen = 20.0f;
+      params.zlen = 3.0f;
+      params.seed = seed;
+      nav::WorldGen gen(params);
+      pntcloud = gen.pntcloud(0.1f, n_threads);
+      std::list<nav::Point> fix_pntcloud;
+      for (size_t i = 0; i < pntcloud.size(); i++) {
+        if ((i / 1000) % 2 == 0)
+          fix_pntcloud.push_back(pntcloud[i]);
+      }
+      planner = nav::Planner(params.xlen, params.ylen, params.zlen, 120, 60, 9,
+                             0.5f, 0.25f, fix_pntcloud);
+    }
+  } catch (const char *err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  } catch (const std::string &err_msg) {
+    std::cerr << err_msg << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  planner.set_int_cost(int_cost);
+
+  // Random missions between free boxes
+  std::vector<size_t> free_boxes;
+  for (size_t ind = 0; ind < planner.n(); ind++) {
+    if (planner.boxes(ind).is_free() && planner.boxes(ind).is_in())
+      free_boxes.push_back(ind);
+  }
+  if (free_boxes.empty()) {
+    std::cerr << "ERROR: No free box found!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, free_boxes.size() - 1);
+  std::vector<nav::Mission> missions(n_missions);
+  for (nav::Mission &mission : missions) {
+    mission.str = planner.boxes(free_boxes[pick(rng)]).cnt();
+    mission.trg = planner.boxes(free_boxes[pick(rng)]).cnt();
+  }
+
+  // Run
+  nav::PointGrid grid(pntcloud);
+  if (!trace_path.empty())
+    nav::trace::start();
+  auto start = std::chrono::steady_clock::now();
+  std::vector<nav::MissionResult> results =
+      nav::run_missions(planner, grid, missions, n_threads, max_steps);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  if (!trace_path.empty()) {
+    nav::trace::stop();
+    try {
+      size_t n_events = nav::trace::write(trace_path);
+      std::cout << n_events << " trace events written to " << trace_path
+                << std::endl;
+    } catch (const char *err_msg) {
+      std::cerr << err_msg << std::endl;
+    }
+  }
+
+  // Summary
+  size_t n_success = 0, n_steps = 0;
+  std::vector<double> step_ms;
+  nav::PlannerStats total_stats;
+  for (size_t i = 0; i < results.size(); i++) {
+    const nav::MissionResult &res = results[i];
+    n_success += res.success;
+    n_steps += res.steps;
+    step_ms.insert(step_ms.end(), res.step_ms.begin(), res.step_ms.end());
+    total_stats.add(res.stats);
+    if (verbose || !res.success) {
+      std::cout << "Mission " << i << ": " << missions[i].str << " -> "
+                << missions[i].trg << " " << res.steps << " steps in "
+                << res.total_ms << " ms";
+      if (res.stats.update_hist.count() > 0)
+        std::cout << ", update p99 " << res.stats.update_hist.percentile_ms(99)
+                  << " ms, max " << res.stats.update_hist.max_ms() << " ms";
+      std::cout << (res.success ? "" : " FAILED: " + res.error) << std::endl;
+    }
+  }
+  std::sort(step_ms.begin(), step_ms.end());
+  double mean_ms = 0.0;
+  for (double ms : step_ms)
+    mean_ms += ms / step_ms.size();
+  std::cout << n_success << "/" << results.size() << " missions succeeded, "
+            << n_steps << " steps in " << elapsed.count() << " s on "
+            << n_threads << " threads (" << n_steps / elapsed.count()
+            << " steps/s)" << std::endl;
+  if (!step_ms.empty()) {
+    std::cout << "Step latency: mean " << mean_ms << " ms, p50 "
+              << step_ms[step_ms.size() / 2] << " ms, p99 "
+              << step_ms[step_ms.size() * 99 / 100] << " ms, max "
+              << step_ms.back() << " ms" << std::endl;
+  }
+  if (total_stats.search_hist.count() > 0) {
+    std::cout << "Search latency: " << total_stats.search_hist.summary()
+              << std::endl;
+    std::cout << "Update latency: " << total_stats.update_hist.summary()
+              << std::endl;
+  }
+  if (stats)
+    std::cout << total_stats.to_json() << std::endl;
+
+  return (n_success == results.size()) ? 0 : 1;
+}
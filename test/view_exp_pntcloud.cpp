@@ -94,6 +94,13 @@ int main() {
           .SetBounds(0.0, 1.0, 0.0, 1.0, (float)-window_width / window_height)
           .SetHandler(&handler);
 
+  // Point clouds, uploaded once at the first frame
+  gl::MeshBuffer fix_buf(GL_POINTS), slam_buf(GL_POINTS);
+  for (const nav::Point &pnt : exp_fix_pntcloud)
+    fix_buf.add_point(pnt);
+  for (const nav::Point &pnt : slam_pntcloud)
+    slam_buf.add_point(pnt);
+
   while (!pangolin::ShouldQuit()) {
     // Clear screen and activate view to render into
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -109,17 +116,9 @@ int main() {
 
     // Points
     glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Point &pnt : exp_fix_pntcloud) {
-      glVertex3f(pnt.x(), pnt.y(), pnt.z());
-    }
-    glEnd();
+    fix_buf.draw();
     glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Point &pnt : slam_pntcloud) {
-      glVertex3f(pnt.x(), pnt.y(), pnt.z());
-    }
-    glEnd();
+    slam_buf.draw();
 
     // Swap frames and Process Events
     pangolin::FinishFrame();
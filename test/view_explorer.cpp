@@ -87,6 +87,20 @@ int main() {
           .SetBounds(0.0, 1.0, 0.0, 1.0, (float)-window_width / window_height)
           .SetHandler(&handler);
 
+  // Map geometry, uploaded once at the first frame
+  gl::MeshBuffer fix_buf(GL_POINTS);
+  gl::MeshBuffer box_buf(GL_TRIANGLES), link_buf(GL_LINES);
+  for (const nav::ExpBox &box : explorer.boxes()) {
+    for (const nav::Point &pnt : box.fix_pnts())
+      fix_buf.add_point(pnt);
+    if (!box.is_free())
+      box_buf.add_box(box.cnt(), exp_map_xstep, exp_map_ystep, exp_map_zstep);
+    for (nav::WtEdge edge : box.edges()) {
+      if (edge.second >= 0.42)
+        link_buf.add_link(box.cnt(), explorer.boxes(edge.first).cnt());
+    }
+  }
+
   while (!pangolin::ShouldQuit()) {
     // Clear screen and activate view to render into
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -102,41 +116,15 @@ int main() {
 
     // Points
     glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::ExpBox &box : explorer.boxes()) {
-      for (const nav::Point &pnt : box.fix_pnts()) {
-        glVertex3f(pnt.x(), pnt.y(), pnt.z());
-      }
-    }
-    glEnd();
-    /*glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::ExpBox &box : exp_map.boxes()) {
-      for (const nav::Point &pnt : box.slam_pnts()) {
-        glVertex3f(pnt.x(), pnt.y(), pnt.z());
-      }
-    }
-    glEnd();*/
+    fix_buf.draw();
 
     // Boxes
     glColor4f(0.2f, 0.2f, 0.2f, 0.1f);
-    for (const nav::ExpBox &box : explorer.boxes()) {
-      if (!box.is_free())
-        gl::draw_box(box.cnt().x(), box.cnt().y(), box.cnt().z(), exp_map_xstep,
-                     exp_map_ystep, exp_map_zstep);
-    }
+    box_buf.draw();
 
     // Links
     glColor4f(0.2f, 0.2f, 0.2f, 0.2f);
-    for (const nav::ExpBox &src : explorer.boxes()) {
-      for (nav::WtEdge edge : src.edges()) {
-        if (edge.second < 0.42)
-          continue;
-        nav::ExpBox dest = explorer.boxes(edge.first);
-        gl::draw_link(src.cnt().x(), src.cnt().y(), src.cnt().z(),
-                      dest.cnt().x(), dest.cnt().y(), dest.cnt().z());
-      }
-    }
+    link_buf.draw();
 
     // Swap frames and Process Events
     pangolin::FinishFrame();
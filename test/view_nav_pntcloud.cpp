@@ -57,6 +57,10 @@ int main() {
   double window_zview = (double)window_cfg["zview"];
   double window_xstart = (double)window_cfg["xstart"];
   double window_ystart = (double)window_cfg["ystart"];
+  // Chunks, coarse cells as multiples of the boxes and their distance
+  float window_chunk = (float)window_cfg["chunk"];
+  float window_cell = (int)window_cfg["lod"] * nav_map_xstep;
+  float window_lod_dist = (float)window_cfg["lod_dist"];
 
   std::list<nav::Point> nav_fix_pntcloud;
   {
@@ -94,10 +98,22 @@ int main() {
           .SetBounds(0.0, 1.0, 0.0, 1.0, (float)-window_width / window_height)
           .SetHandler(&handler);
 
+  // Point clouds in chunks, uploaded once at the first frame
+  gl::Frustum frustum;
+  gl::ChunkGrid fix_grid(GL_POINTS, nav_map_xlen, nav_map_ylen, window_chunk,
+                         window_cell, window_lod_dist);
+  gl::ChunkGrid slam_grid(GL_POINTS, nav_map_xlen, nav_map_ylen, window_chunk,
+                          window_cell, window_lod_dist);
+  for (const nav::Point &pnt : nav_fix_pntcloud)
+    fix_grid.add_point(pnt);
+  for (const nav::Point &pnt : slam_pntcloud)
+    slam_grid.add_point(pnt);
+
   while (!pangolin::ShouldQuit()) {
     // Clear screen and activate view to render into
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     d_cam.Activate(s_cam);
+    frustum.update();
     glClearColor(1.0f, 1.0f, 1.0f, 0.2f);
 
     // Origin
@@ -109,17 +125,9 @@ int main() {
 
     // Points
     glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Point &pnt : nav_fix_pntcloud) {
-      glVertex3f(pnt.x(), pnt.y(), pnt.z());
-    }
-    glEnd();
+    fix_grid.draw(frustum);
     glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Point &pnt : slam_pntcloud) {
-      glVertex3f(pnt.x(), pnt.y(), pnt.z());
-    }
-    glEnd();
+    slam_grid.draw(frustum);
 
     // Swap frames and Process Events
     pangolin::FinishFrame();
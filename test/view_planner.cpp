@@ -57,6 +57,10 @@ int main() {
   double window_zview = (double)window_cfg["zview"];
   double window_xstart = (double)window_cfg["xstart"];
   double window_ystart = (double)window_cfg["ystart"];
+  // Chunks, coarse cells as multiples of the boxes and their distance
+  float window_chunk = (float)window_cfg["chunk"];
+  float window_cell = (int)window_cfg["lod"] * nav_map_xstep;
+  float window_lod_dist = (float)window_cfg["lod_dist"];
 
   nav::Planner planner;
   {
@@ -87,10 +91,34 @@ int main() {
           .SetBounds(0.0, 1.0, 0.0, 1.0, (float)-window_width / window_height)
           .SetHandler(&handler);
 
+  // Map geometry in chunks, uploaded once at the first frame
+  gl::Frustum frustum;
+  gl::ChunkGrid fix_grid(GL_POINTS, nav_map_xlen, nav_map_ylen, window_chunk,
+                         window_cell, window_lod_dist);
+  gl::ChunkGrid slam_grid(GL_POINTS, nav_map_xlen, nav_map_ylen, window_chunk,
+                          window_cell, window_lod_dist);
+  gl::ChunkGrid box_grid(GL_TRIANGLES, nav_map_xlen, nav_map_ylen, window_chunk,
+                         window_cell, window_lod_dist);
+  gl::ChunkGrid link_grid(GL_LINES, nav_map_xlen, nav_map_ylen, window_chunk,
+                          window_cell, window_lod_dist);
+  for (const nav::Box &box : planner.boxes()) {
+    for (const nav::Point &pnt : box.fix_pnts())
+      fix_grid.add_point(pnt);
+    for (const nav::Point &pnt : box.slam_pnts())
+      slam_grid.add_point(pnt);
+    if (!box.is_free())
+      box_grid.add_box(box.cnt(), nav_map_xstep, nav_map_ystep, nav_map_zstep);
+    for (nav::WtEdge edge : box.edges()) {
+      if (edge.second >= 0.42)
+        link_grid.add_link(box.cnt(), planner.boxes(edge.first).cnt());
+    }
+  }
+
   while (!pangolin::ShouldQuit()) {
     // Clear screen and activate view to render into
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     d_cam.Activate(s_cam);
+    frustum.update();
     glClearColor(1.0f, 1.0f, 1.0f, 0.2f);
 
     // Origin
@@ -102,42 +130,18 @@ int main() {
 
     // Fixed points
     glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Box &box : planner.boxes()) {
-      for (const nav::Point &pnt : box.fix_pnts()) {
-        glVertex3f(pnt.x(), pnt.y(), pnt.z());
-      }
-    }
-    glEnd();
+    fix_grid.draw(frustum);
     // SLAM points
     glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_POINTS);
-    for (const nav::Box &box : planner.boxes()) {
-      for (const nav::Point &pnt : box.slam_pnts()) {
-        glVertex3f(pnt.x(), pnt.y(), pnt.z());
-      }
-    }
-    glEnd();
+    slam_grid.draw(frustum);
 
     // Boxes
     glColor4f(0.2f, 0.2f, 0.2f, 0.1f);
-    for (const nav::Box &box : planner.boxes()) {
-      if (!box.is_free())
-        gl::draw_box(box.cnt().x(), box.cnt().y(), box.cnt().z(), nav_map_xstep,
-                     nav_map_ystep, nav_map_zstep);
-    }
+    box_grid.draw(frustum);
 
     // Links
     glColor4f(0.2f, 0.2f, 0.2f, 0.2f);
-    for (const nav::Box &src : planner.boxes()) {
-      for (nav::WtEdge edge : src.edges()) {
-        if (edge.second < 0.42)
-          continue;
-        nav::Box dest = planner.boxes(edge.first);
-        gl::draw_link(src.cnt().x(), src.cnt().y(), src.cnt().z(),
-                      dest.cnt().x(), dest.cnt().y(), dest.cnt().z());
-      }
-    }
+    link_grid.draw(frustum);
 
     // Swap frames and Process Events
     pangolin::FinishFrame();